@@ -0,0 +1,239 @@
+#include "ChordAutomaton.h"
+#include "EquipsetManager.h"
+#include "Config.h"
+
+int64_t ChordAutomaton::Now() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+uint64_t ChordAutomaton::GetToken(Equipset* _equipset) {
+    return EquipsetManager::GetChordKey(_equipset->hotkey, _equipset->modifier1, _equipset->modifier2,
+                                        _equipset->modifier3, _equipset->padMask);
+}
+
+uint64_t ChordAutomaton::GetLeaderToken(Equipset* _equipset) {
+    if (_equipset->leader == 0) return 0U;
+
+    return EquipsetManager::GetChordKey(_equipset->leader, false, false, false);
+}
+
+uint32_t ChordAutomaton::NewNode() {
+    if (!freeNodes.empty()) {
+        auto index = freeNodes.back();
+        freeNodes.pop_back();
+        return index;
+    }
+
+    nodes.push_back(Node{});
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void ChordAutomaton::ResetState() {
+    state = root;
+    heldNode = none;
+    tapNode = none;
+    isPressFired = false;
+    isHoldFired = false;
+}
+
+bool ChordAutomaton::Add(Equipset* _equipset) {
+    if (!_equipset || _equipset->hotkey == 0) return false;
+
+    std::array<uint64_t, 2> path{GetLeaderToken(_equipset), GetToken(_equipset)};
+    auto gesture = static_cast<uint32_t>(_equipset->gesture);
+
+    // Walk the existing prefix first so a taken slot is refused before any node is created.
+    uint32_t current = root;
+    uint32_t depth = 0U;
+    for (; depth < path.size(); depth++) {
+        if (path[depth] == 0U) continue;
+
+        auto it = nodes[current].next.find(path[depth]);
+        if (it == nodes[current].next.end()) break;
+        current = it->second;
+    }
+
+    if (depth == path.size() && nodes[current].accept[gesture]) return false;
+
+    for (; depth < path.size(); depth++) {
+        if (path[depth] == 0U) continue;
+
+        auto index = NewNode();
+        nodes[current].next.insert(std::make_pair(path[depth], index));
+        current = index;
+    }
+
+    nodes[current].accept[gesture] = _equipset->handle;
+    return true;
+}
+
+bool ChordAutomaton::Remove(Equipset* _equipset) {
+    if (!_equipset || _equipset->hotkey == 0) return false;
+
+    std::array<uint64_t, 2> path{GetLeaderToken(_equipset), GetToken(_equipset)};
+    std::array<std::pair<uint32_t, uint64_t>, 2> visited;
+    uint32_t depth = 0U;
+
+    uint32_t current = root;
+    for (const auto& token : path) {
+        if (token == 0U) continue;
+
+        auto it = nodes[current].next.find(token);
+        if (it == nodes[current].next.end()) return false;
+
+        visited[depth++] = std::make_pair(current, token);
+        current = it->second;
+    }
+
+    auto& slot = nodes[current].accept[static_cast<uint32_t>(_equipset->gesture)];
+    if (slot != _equipset->handle) return false;
+    slot = 0U;
+
+    // Prune nodes left without bindings or children.
+    while (depth > 0) {
+        auto& node = nodes[current];
+        if (!node.next.empty() || std::ranges::any_of(node.accept, [](auto elem) { return elem != 0U; })) break;
+
+        auto [parent, token] = visited[--depth];
+        nodes[parent].next.erase(token);
+        freeNodes.push_back(current);
+        current = parent;
+    }
+
+    ResetState();
+    return true;
+}
+
+void ChordAutomaton::Clear() {
+    nodes.clear();
+    nodes.push_back(Node{});
+    freeNodes.clear();
+    ResetState();
+}
+
+uint32_t ChordAutomaton::Search(const uint64_t& _token, const uint64_t& _leader, Equipset::GESTURE _gesture) {
+    uint32_t current = root;
+    for (const auto& token : {_leader, _token}) {
+        if (token == 0U) continue;
+
+        auto it = nodes[current].next.find(token);
+        if (it == nodes[current].next.end()) return 0U;
+
+        current = it->second;
+    }
+
+    if (current == root) return 0U;
+
+    return nodes[current].accept[static_cast<uint32_t>(_gesture)];
+}
+
+uint32_t ChordAutomaton::Press(const uint64_t& _token) {
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return 0U;
+
+    using GESTURE = Equipset::GESTURE;
+    auto now = Now();
+
+    if (state != root && now > stateExpire) state = root;
+
+    auto it = nodes[state].next.find(_token);
+    if (it == nodes[state].next.end() && state != root) {
+        // A modifier pressed while a leader waits belongs to the chord that follows it.
+        auto hotkey = EquipsetManager::GetChordHotkey(_token);
+        if (hotkey == config->Settings.modifier1 || hotkey == config->Settings.modifier2 ||
+            hotkey == config->Settings.modifier3) {
+            return 0U;
+        }
+
+        state = root;
+        it = nodes[state].next.find(_token);
+    }
+
+    isPressFired = false;
+    isHoldFired = false;
+
+    if (it == nodes[state].next.end()) {
+        heldNode = none;
+        tapNode = none;
+        return 0U;
+    }
+
+    auto index = it->second;
+    const auto& node = nodes[index];
+
+    if (!node.next.empty()) {
+        state = index;
+        stateExpire = now + static_cast<int64_t>(config->Settings.leaderTimeout * 1000000.0f);
+    } else {
+        state = root;
+    }
+
+    heldToken = _token;
+    heldNode = index;
+
+    auto doubleTap = node.accept[static_cast<uint32_t>(GESTURE::DOUBLE_TAP)];
+    if (doubleTap && tapNode == index &&
+        now - tapTime <= static_cast<int64_t>(config->Settings.doubleTapTime * 1000000.0f)) {
+        tapNode = none;
+        return doubleTap;
+    }
+
+    tapNode = index;
+    tapTime = now;
+
+    // A press that shares its chord with a hold binding waits for release to tell them apart.
+    auto press = node.accept[static_cast<uint32_t>(GESTURE::PRESS)];
+    if (press && !node.accept[static_cast<uint32_t>(GESTURE::HOLD)]) {
+        isPressFired = true;
+        return press;
+    }
+
+    return 0U;
+}
+
+uint32_t ChordAutomaton::Held(const uint64_t& _token, float _time) {
+    // Held and released keys match on the hotkey alone, so letting go of a modifier first still ends the gesture.
+    auto hotkey = EquipsetManager::GetChordHotkey(_token);
+    if (heldNode == none || hotkey != EquipsetManager::GetChordHotkey(heldToken) || isHoldFired) return 0U;
+
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return 0U;
+
+    auto hold = nodes[heldNode].accept[static_cast<uint32_t>(Equipset::GESTURE::HOLD)];
+    if (!hold || _time < config->Settings.holdTime) return 0U;
+
+    isHoldFired = true;
+    tapNode = none;
+    return hold;
+}
+
+ChordAutomaton::Result ChordAutomaton::Release(const uint64_t& _token, float _time) {
+    Result result;
+    auto hotkey = EquipsetManager::GetChordHotkey(_token);
+    if (heldNode == none || hotkey != EquipsetManager::GetChordHotkey(heldToken)) return result;
+
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return result;
+
+    using GESTURE = Equipset::GESTURE;
+    const auto& node = nodes[heldNode];
+    auto press = node.accept[static_cast<uint32_t>(GESTURE::PRESS)];
+    auto hold = node.accept[static_cast<uint32_t>(GESTURE::HOLD)];
+
+    if (isPressFired) {
+        result.release = press;
+    } else if (hold && !isHoldFired) {
+        if (_time >= config->Settings.holdTime) {
+            result.fire = hold;
+        } else {
+            result.fire = press;
+        }
+    }
+
+    heldNode = none;
+    isPressFired = false;
+    isHoldFired = false;
+
+    return result;
+}
\ No newline at end of file
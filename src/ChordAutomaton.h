@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Equipset.h"
+
+// Trie over chord tokens (EquipsetManager::GetChordKey) with per-node gesture slots holding equipset handles.
+// Leader bindings are two-token paths, so every input event costs one hash probe.
+class ChordAutomaton {
+public:
+    struct Result {
+        uint32_t fire{0U};
+        uint32_t release{0U};
+    };
+
+    // Add refuses a chord whose gesture slot is taken; Remove reports whether it freed the set's slot.
+    bool Add(Equipset* _equipset);
+    bool Remove(Equipset* _equipset);
+    void Clear();
+    void ResetState();
+    uint32_t Search(const uint64_t& _token, const uint64_t& _leader, Equipset::GESTURE _gesture);
+
+    uint32_t Press(const uint64_t& _token);
+    uint32_t Held(const uint64_t& _token, float _time);
+    Result Release(const uint64_t& _token, float _time);
+
+    static uint64_t GetToken(Equipset* _equipset);
+    static uint64_t GetLeaderToken(Equipset* _equipset);
+
+private:
+    static constexpr uint32_t root{0U};
+    static constexpr uint32_t none{UINT32_MAX};
+
+    struct Node {
+        std::unordered_map<uint64_t, uint32_t> next;
+        std::array<uint32_t, 3> accept{};
+    };
+
+    std::vector<Node> nodes{Node{}};
+    std::vector<uint32_t> freeNodes;
+
+    uint32_t state{root};
+    int64_t stateExpire{0};
+
+    uint64_t heldToken{0U};
+    uint32_t heldNode{none};
+    bool isPressFired{false};
+    bool isHoldFired{false};
+
+    uint32_t tapNode{none};
+    int64_t tapTime{0};
+
+    uint32_t NewNode();
+    static int64_t Now();
+};
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Utility.h"
+#include "FormResolver.h"
+
+// Field descriptors for the ";##;" packed string format. A Schema lists a type's fields in wire order and
+// generates both Pack and Unpack from that list; tokens are parsed in place without allocating.
+namespace Codec {
+    class Tokenizer {
+    public:
+        explicit Tokenizer(std::string_view _packed) : rest(_packed) {}
+
+        // Every field is followed by a delimiter; a trailing field without one is still accepted.
+        bool Next(std::string_view& _token) {
+            if (rest.empty()) return false;
+
+            auto index = rest.find(Utility::delimiter);
+            if (index == std::string_view::npos) {
+                _token = rest;
+                rest = {};
+                return true;
+            }
+
+            _token = rest.substr(0, index);
+            rest.remove_prefix(index + Utility::delimiter.size());
+            return true;
+        }
+
+    private:
+        std::string_view rest;
+    };
+
+    template <class V>
+    void Write(std::string& _out, const V& _value) {
+        if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+            _out += std::string_view(_value);
+        } else if constexpr (std::is_same_v<V, bool>) {
+            _out += _value ? '1' : '0';
+        } else if constexpr (std::is_enum_v<V>) {
+            Write(_out, static_cast<uint32_t>(_value));
+            return;
+        } else if constexpr (std::is_floating_point_v<V>) {
+            // Same text as std::to_string, which prints six decimals.
+            char buffer[64];
+            auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), _value, std::chars_format::fixed, 6);
+            _out.append(buffer, ptr);
+        } else {
+            char buffer[24];
+            auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), _value);
+            _out.append(buffer, ptr);
+        }
+        _out += Utility::delimiter;
+    }
+
+    template <class V>
+    bool Read(std::string_view _token, V& _value) {
+        if constexpr (std::is_same_v<V, std::string>) {
+            _value.assign(_token);
+            return true;
+        } else if constexpr (std::is_same_v<V, bool>) {
+            _value = _token == "1";
+            return true;
+        } else if constexpr (std::is_enum_v<V>) {
+            uint32_t raw;
+            if (!Read(_token, raw)) return false;
+
+            _value = static_cast<V>(raw);
+            return true;
+        } else {
+            auto [ptr, ec] = std::from_chars(_token.data(), _token.data() + _token.size(), _value);
+            return ec == std::errc{};
+        }
+    }
+
+    // A plain member: string, bool, enum or number.
+    template <auto Member>
+    struct Value {
+        template <class T>
+        static void Encode(const T& _object, std::string& _out) {
+            Write(_out, _object.*Member);
+        }
+
+        template <class T>
+        static bool Decode(T& _object, Tokenizer& _tokens, FormResolver*) {
+            std::string_view token;
+            return _tokens.Next(token) && Read(token, _object.*Member);
+        }
+    };
+
+    // A form pointer, written as two fields: FormID and plugin name.
+    // With isDynamic, forms created at runtime keep their full FormID and an empty plugin name.
+    template <auto Member, bool isDynamic = false>
+    struct Form {
+        template <class T>
+        static void Encode(const T& _object, std::string& _out) {
+            auto form = _object.*Member;
+            auto file = form ? form->GetFile(0) : nullptr;
+
+            RE::FormID id = 0;
+            if (form) id = isDynamic && form->IsDynamicForm() ? form->GetFormID() : form->GetLocalFormID();
+
+            Write(_out, id);
+            Write(_out, file ? file->GetFilename() : ""sv);
+        }
+
+        // With a resolver the lookup is deferred to FormResolver::Resolve.
+        template <class T>
+        static bool Decode(T& _object, Tokenizer& _tokens, FormResolver* _resolver) {
+            std::string_view idToken;
+            std::string_view modname;
+            RE::FormID id;
+            if (!_tokens.Next(idToken) || !Read(idToken, id)) return false;
+            if (!_tokens.Next(modname)) modname = {};
+
+            if (_resolver) {
+                _resolver->Defer(std::addressof(_object.*Member), id, modname, isDynamic);
+                return true;
+            }
+
+            _object.*Member = nullptr;
+            if (id == 0) return true;
+
+            if (modname.empty()) {
+                if (isDynamic) _object.*Member = RE::TESForm::LookupByID(id);
+                return true;
+            }
+
+            auto TESDataHandler = RE::TESDataHandler::GetSingleton();
+            _object.*Member = TESDataHandler ? TESDataHandler->LookupForm(id, modname) : nullptr;
+            return true;
+        }
+    };
+
+    template <class T, class... Fields>
+    struct Schema {
+        static std::string Pack(const T& _object) {
+            std::string result;
+            (Fields::Encode(_object, result), ...);
+            return result;
+        }
+
+        // Fields are filled in order; on failure the remaining ones keep their defaults.
+        static bool Unpack(std::string_view _packed, T& _object, FormResolver* _resolver = nullptr) {
+            Tokenizer tokens(_packed);
+            return (Fields::Decode(_object, tokens, _resolver) && ...);
+        }
+    };
+}
\ No newline at end of file
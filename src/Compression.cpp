@@ -0,0 +1,123 @@
+#include "Compression.h"
+
+namespace {
+    constexpr size_t minMatch{4};
+    constexpr size_t maxOffset{65535};
+    constexpr uint32_t hashBits{12};
+
+    uint32_t Load32(std::span<const uint8_t> _data, size_t _pos) {
+        uint32_t result;
+        std::memcpy(&result, _data.data() + _pos, sizeof(result));
+        return result;
+    }
+
+    uint32_t Hash(uint32_t _sequence) {
+        return (_sequence * 2654435761U) >> (32 - hashBits);
+    }
+
+    void WriteLength(std::vector<uint8_t>& _out, size_t _length) {
+        for (; _length >= 255; _length -= 255) {
+            _out.push_back(255);
+        }
+        _out.push_back(static_cast<uint8_t>(_length));
+    }
+
+    bool ReadLength(std::span<const uint8_t> _data, size_t& _pos, size_t& _length) {
+        uint8_t byte;
+        do {
+            if (_pos >= _data.size()) return false;
+            byte = _data[_pos++];
+            _length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    void WriteSequence(std::vector<uint8_t>& _out, std::span<const uint8_t> _literals, size_t _offset,
+                       size_t _matchLength) {
+        auto matchCode = _matchLength - minMatch;
+        auto literalNibble = std::min<size_t>(_literals.size(), 15);
+        auto matchNibble = _matchLength ? std::min<size_t>(matchCode, 15) : 0;
+        _out.push_back(static_cast<uint8_t>((literalNibble << 4) | matchNibble));
+        if (literalNibble == 15) WriteLength(_out, _literals.size() - 15);
+        _out.insert(_out.end(), _literals.begin(), _literals.end());
+
+        if (!_matchLength) return;
+
+        _out.push_back(static_cast<uint8_t>(_offset));
+        _out.push_back(static_cast<uint8_t>(_offset >> 8));
+        if (matchNibble == 15) WriteLength(_out, matchCode - 15);
+    }
+}
+
+namespace Compression {
+    std::vector<uint8_t> Compress(std::span<const uint8_t> _data) {
+        std::vector<uint8_t> result;
+        result.reserve(_data.size() + _data.size() / 255 + 16);
+
+        // Last position of each hashed 4-byte sequence, offset by one so zero means empty.
+        std::vector<uint32_t> table(size_t{1} << hashBits, 0U);
+        size_t anchor = 0;
+        size_t pos = 0;
+
+        while (pos + minMatch <= _data.size()) {
+            auto sequence = Load32(_data, pos);
+            auto& slot = table[Hash(sequence)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(pos + 1);
+
+            if (candidate == 0 || pos + 1 - candidate > maxOffset || Load32(_data, candidate - 1) != sequence) {
+                pos++;
+                continue;
+            }
+
+            candidate--;
+            auto length = minMatch;
+            while (pos + length < _data.size() && _data[candidate + length] == _data[pos + length]) {
+                length++;
+            }
+
+            WriteSequence(result, _data.subspan(anchor, pos - anchor), pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+
+        WriteSequence(result, _data.subspan(anchor), 0, 0);
+        return result;
+    }
+
+    bool Decompress(std::span<const uint8_t> _data, size_t _size, std::vector<uint8_t>& _out) {
+        _out.clear();
+        _out.reserve(_size);
+
+        size_t pos = 0;
+        while (pos < _data.size()) {
+            auto token = _data[pos++];
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(_data, pos, literalLength)) return false;
+            if (literalLength > _data.size() - pos || literalLength > _size - _out.size()) return false;
+
+            _out.insert(_out.end(), _data.begin() + pos, _data.begin() + pos + literalLength);
+            pos += literalLength;
+            if (pos == _data.size()) break;
+
+            if (_data.size() - pos < 2) return false;
+            size_t offset = _data[pos] | (static_cast<size_t>(_data[pos + 1]) << 8);
+            pos += 2;
+            if (offset == 0 || offset > _out.size()) return false;
+
+            size_t matchLength = token & 0x0F;
+            if (matchLength == 15 && !ReadLength(_data, pos, matchLength)) return false;
+            matchLength += minMatch;
+            if (matchLength > _size - _out.size()) return false;
+
+            // Byte by byte, since a match may overlap the bytes it is producing.
+            auto from = _out.size() - offset;
+            for (size_t i = 0; i < matchLength; i++) {
+                _out.push_back(_out[from + i]);
+            }
+        }
+
+        return _out.size() == _size;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+// In-tree LZ77 block codec in the LZ4 sequence format: a token byte holds the literal and match
+// length nibbles (15 means more length bytes follow, each 255 adding on), then the literals, a 16-bit
+// little-endian back offset and the match length extension. The last sequence carries literals only.
+namespace Compression {
+    std::vector<uint8_t> Compress(std::span<const uint8_t> _data);
+    // Fails on malformed input or if the output would not come to exactly _size bytes.
+    bool Decompress(std::span<const uint8_t> _data, size_t _size, std::vector<uint8_t>& _out);
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Config.h"
+#include "FileWriter.h"
 
 #include <filesystem>
 #include <toml++/toml.h>
@@ -6,6 +7,7 @@
 const std::filesystem::path config_path = "Data/SKSE/Plugins/UIHS/Config.toml";
 const std::filesystem::path widgets_path = "Data/SKSE/Plugins/UIHS/Widgets.toml";
 const std::filesystem::path potions_path = "Data/SKSE/Plugins/UIHS/Potions.toml";
+const std::filesystem::path keymap_path = "Data/SKSE/Plugins/UIHS/Keymap.toml";
 
 void ConfigHandler::LoadConfig() {
     ConfigHandler::Clear();
@@ -65,6 +67,33 @@ void ConfigHandler::LoadConfig() {
         this->Settings.modifier3 = tbl["Settings"]["modifier3"].value_or<ImGuiKey>(ImGuiKey_ModAlt);
         this->Settings.sort = tbl["Settings"]["sort_order"].value_or<uint32_t>(0);
         this->Settings.favorOnly = tbl["Settings"]["favor_only"].value_or<bool>(false);
+        this->Settings.holdTime = tbl["Settings"]["hold_time"].value_or<float>(0.5f);
+        this->Settings.doubleTapTime = tbl["Settings"]["double_tap_time"].value_or<float>(0.3f);
+        this->Settings.leaderTimeout = tbl["Settings"]["leader_timeout"].value_or<float>(1.0f);
+        this->Settings.layerHotkey = tbl["Settings"]["layer_hotkey"].value_or<uint32_t>(0);
+        this->Settings.compressCosave = tbl["Settings"]["compress_cosave"].value_or<bool>(true);
+
+        this->Settings.layers = {"Default"};
+        auto layersArr = tbl["Settings"]["layers"].as_array();
+        if (layersArr && !layersArr->empty()) {
+            this->Settings.layers.clear();
+            layersArr->for_each([this](auto&& elem) {
+                if constexpr (toml::is_string<decltype(elem)>) {
+                    this->Settings.layers.push_back(*elem);
+                }
+            });
+        }
+
+        this->Settings.blockMenus = Config::default_block_menus;
+        auto blockMenusArr = tbl["Settings"]["block_menus"].as_array();
+        if (blockMenusArr) {
+            this->Settings.blockMenus.clear();
+            blockMenusArr->for_each([this](auto&& elem) {
+                if constexpr (toml::is_string<decltype(elem)>) {
+                    this->Settings.blockMenus.push_back(*elem);
+                }
+            });
+        }
 
         this->Gui.fontPath = tbl["Gui"]["font_path"].value_or<std::string>("NotoSans-Medium.otf");
         this->Gui.fontSize = tbl["Gui"]["font_size"].value_or<float>(13.0f);
@@ -166,18 +195,52 @@ void ConfigHandler::LoadConfig() {
             });
         }
 
+        ResolvePotionEffects();
         logger::info("Potion data loaded.");
     } catch (const toml::parse_error& err) {
         logger::error("Failed to parse potion file. \nError: {}", err.description());
     }
+
+    if (std::filesystem::exists(keymap_path)) {
+        try {
+            auto tbl = toml::parse_file(keymap_path.c_str());
+            for (int i = 0; i < 2; i++) {
+                auto arr = i == 0 ? tbl["Keyboard"].as_array() : tbl["Gamepad"].as_array();
+                if (!arr) continue;
+
+                arr->for_each([this, i](auto&& elem) {
+                    if constexpr (toml::is_table<decltype(elem)>) {
+                        auto code = elem["code"].value_or<uint32_t>(0);
+                        auto key = elem["key"].value_or<uint32_t>(ImGuiKey_None);
+
+                        ConfigHandler::KeymapInfo info;
+                        info.code = code;
+                        info.key = key;
+
+                        if (i == 0) keyboardVec.push_back(info);
+                        else if (i == 1) gamepadVec.push_back(info);
+                    }
+                });
+            }
+
+            logger::info("Keymap data loaded.");
+        } catch (const toml::parse_error& err) {
+            logger::error("Failed to parse keymap file. \nError: {}", err.description());
+        }
+    }
 }
 
 void ConfigHandler::SaveConfig() {
-    std::ofstream f(config_path);
-    if (!f.is_open()) {
-        logger::error("Failed to save configuration!");
-        return;
+    toml::array layersArr;
+    for (const auto& layer : this->Settings.layers) {
+        layersArr.push_back(layer);
+    }
+
+    toml::array blockMenusArr;
+    for (const auto& menu : this->Settings.blockMenus) {
+        blockMenusArr.push_back(menu);
     }
+
     auto tbl = toml::table{
         {"Widget", toml::table{
                 {"general_font", this->Widget.General.font},
@@ -228,6 +291,13 @@ void ConfigHandler::SaveConfig() {
                 {"modifier3", this->Settings.modifier3},
                 {"sort_order", this->Settings.sort},
                 {"favor_only", this->Settings.favorOnly},
+                {"hold_time", this->Settings.holdTime},
+                {"double_tap_time", this->Settings.doubleTapTime},
+                {"leader_timeout", this->Settings.leaderTimeout},
+                {"layer_hotkey", this->Settings.layerHotkey},
+                {"compress_cosave", this->Settings.compressCosave},
+                {"layers", layersArr},
+                {"block_menus", blockMenusArr},
             }
         },
         {"Gui", toml::table{
@@ -242,10 +312,30 @@ void ConfigHandler::SaveConfig() {
             }
         },
     };
-    f << tbl;
+    // The table is the snapshot; streaming it out happens on the writer thread.
+    FileWriter::GetSingleton()->Write(config_path, [tbl = std::move(tbl)](std::ostream& _stream) { _stream << tbl; });
     logger::info("Configuration saved.");
 }
 
+void ConfigHandler::ResolvePotionEffects() {
+    potionEffectMap.clear();
+
+    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
+    if (!TESDataHandler) return;
+
+    for (auto [vec, flag] : {std::make_pair(&healthVec, Config::POTION_HEALTH),
+                             std::make_pair(&magickaVec, Config::POTION_MAGICKA),
+                             std::make_pair(&staminaVec, Config::POTION_STAMINA)}) {
+        for (const auto& elem : *vec) {
+            // Zero until kDataLoaded, or when the plugin is not in the load order.
+            auto formid = TESDataHandler->LookupFormID(elem.formid, elem.modname);
+            if (formid == 0) continue;
+
+            potionEffectMap[formid] |= flag;
+        }
+    }
+}
+
 std::string ConfigHandler::GetWidgetPath(const std::string& _type) {
     return widgetMap[_type].path;
 }
@@ -256,4 +346,7 @@ void ConfigHandler::Clear() {
     healthVec.clear();
     magickaVec.clear();
     staminaVec.clear();
+    potionEffectMap.clear();
+    keyboardVec.clear();
+    gamepadVec.clear();
 }
\ No newline at end of file
@@ -43,10 +43,22 @@ namespace Config {
         CLASSIC
     };
 
+    // Restore lists a magic effect counts toward, one bit each.
+    enum PotionFlag : uint8_t {
+        POTION_HEALTH = 1 << 0,
+        POTION_MAGICKA = 1 << 1,
+        POTION_STAMINA = 1 << 2
+    };
+
     const int icon_smin = -320;
     const int icon_smax = 1600;
     const int text_smin = -200;
     const int text_smax = 200;
+
+    // Menus that suppress equipset hotkeys while open.
+    inline const std::vector<std::string> default_block_menus{
+        "MapMenu",       "InventoryMenu", "MagicMenu",     "TweenMenu", "Dialogue Menu",
+        "BarterMenu",    "Crafting Menu", "ContainerMenu", "Console",   "LootMenu"};
 } // namespace Config
 
 class ConfigHandler {
@@ -91,6 +103,13 @@ public:
         uint32_t modifier3{643};
         uint32_t sort{(uint32_t)Config::SortType::CREATEASC};
         bool favorOnly{false};
+        float holdTime{0.5f};
+        float doubleTapTime{0.3f};
+        float leaderTimeout{1.0f};
+        uint32_t layerHotkey{0U};
+        bool compressCosave{true};
+        std::vector<std::string> layers{"Default"};
+        std::vector<std::string> blockMenus{Config::default_block_menus};
     } Settings;
 
     struct config_gui {
@@ -115,6 +134,11 @@ public:
         std::string modname;
     };
 
+    struct KeymapInfo {
+        uint32_t code;
+        uint32_t key;
+    };
+
     struct EquipmentWidgetInfo {
         std::string id{""};
         std::string keyword{""};
@@ -128,9 +152,20 @@ public:
     std::vector<PotionInfo> healthVec;
     std::vector<PotionInfo> magickaVec;
     std::vector<PotionInfo> staminaVec;
+    std::vector<KeymapInfo> keyboardVec;
+    std::vector<KeymapInfo> gamepadVec;
+    // Key: load-order FormID of a configured restore effect
+    // Value: Config::PotionFlag bits
+    std::unordered_map<RE::FormID, uint8_t> potionEffectMap;
 
     void LoadConfig();
     void SaveConfig();
+    // Rebuilds potionEffectMap from the three lists; needs the plugins loaded to resolve anything.
+    void ResolvePotionEffects();
+    uint8_t GetPotionFlags(RE::FormID _formid) const {
+        auto it = potionEffectMap.find(_formid);
+        return it != potionEffectMap.end() ? it->second : 0U;
+    }
     std::string GetWidgetPath(const std::string& _type);
     void Clear();
 
@@ -0,0 +1,1014 @@
+#include "Cosave.h"
+#include "EquipsetManager.h"
+#include "FileWriter.h"
+#include "Compression.h"
+#include "Config.h"
+#include "FormResolver.h"
+
+const std::filesystem::path library_path = "Data/SKSE/Plugins/UIHS/Library";
+
+namespace {
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view _name) const { return std::hash<std::string_view>{}(_name); }
+    };
+
+    class Writer {
+    public:
+        std::vector<uint8_t> body;
+
+        void Varint(uint64_t _value) {
+            while (_value >= 0x80) {
+                body.push_back(static_cast<uint8_t>(_value | 0x80));
+                _value >>= 7;
+            }
+            body.push_back(static_cast<uint8_t>(_value));
+        }
+
+        void Zigzag(int32_t _value) {
+            Varint((static_cast<uint32_t>(_value) << 1) ^ static_cast<uint32_t>(_value >> 31));
+        }
+
+        void Float(float _value) {
+            auto bits = std::bit_cast<uint32_t>(_value);
+            for (int i = 0; i < 4; i++) {
+                body.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+            }
+        }
+
+        void Fixed64(uint64_t _value) {
+            for (int i = 0; i < 8; i++) {
+                body.push_back(static_cast<uint8_t>(_value >> (i * 8)));
+            }
+        }
+
+        void String(std::string_view _value) {
+            auto [it, inserted] = stringMap.try_emplace(std::string(_value), static_cast<uint32_t>(strings.size()));
+            if (inserted) strings.push_back(it->first);
+            Varint(it->second);
+        }
+
+        void Form(RE::TESForm* _form) {
+            if (!_form) {
+                Varint(0U);
+                String("");
+                return;
+            }
+
+            // Dynamic forms live in the save itself and are looked up by their full FormID.
+            if (_form->IsDynamicForm()) {
+                Varint(_form->GetFormID());
+                String("");
+                return;
+            }
+
+            auto file = _form->GetFile(0);
+            Varint(_form->GetLocalFormID());
+            String(file ? file->GetFilename() : ""sv);
+        }
+
+        // Prepends the string table, so the result decodes on its own.
+        std::vector<uint8_t> Finish() {
+            Writer result;
+            result.Varint(strings.size());
+            for (const auto& elem : strings) {
+                result.Varint(elem.size());
+                result.body.insert(result.body.end(), elem.begin(), elem.end());
+            }
+            result.body.insert(result.body.end(), body.begin(), body.end());
+            return std::move(result.body);
+        }
+
+    private:
+        std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> stringMap;
+        std::vector<std::string_view> strings;
+    };
+
+    class Reader {
+    public:
+        // Form references are deferred to _resolver, which must outlive the fields they are read into.
+        explicit Reader(std::span<const uint8_t> _data, FormResolver* _resolver = nullptr)
+            : data(_data), resolver(_resolver) {}
+
+        bool IsGood() const { return isGood; }
+
+        uint64_t Varint() {
+            uint64_t result = 0U;
+            for (uint32_t shift = 0; shift < 64; shift += 7) {
+                if (pos >= data.size()) return Fail();
+
+                auto byte = data[pos++];
+                result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return result;
+            }
+            return Fail();
+        }
+
+        uint32_t U32() { return static_cast<uint32_t>(Varint()); }
+
+        // Every element takes at least one byte, so a larger count is corruption rather than a huge allocation.
+        uint32_t Count() {
+            auto count = Varint();
+            if (count > data.size() - pos) return static_cast<uint32_t>(Fail());
+            return static_cast<uint32_t>(count);
+        }
+        bool Bool() { return Varint() != 0; }
+
+        int32_t Zigzag() {
+            auto value = U32();
+            return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        float Float() {
+            if (data.size() - pos < 4) return static_cast<float>(Fail());
+
+            uint32_t bits = 0U;
+            for (int i = 0; i < 4; i++) {
+                bits |= static_cast<uint32_t>(data[pos++]) << (i * 8);
+            }
+            return std::bit_cast<float>(bits);
+        }
+
+        uint64_t Fixed64() {
+            if (data.size() - pos < 8) return Fail();
+
+            uint64_t result = 0U;
+            for (int i = 0; i < 8; i++) {
+                result |= static_cast<uint64_t>(data[pos++]) << (i * 8);
+            }
+            return result;
+        }
+
+        const std::string& String() {
+            static const std::string empty;
+            auto index = Varint();
+            if (index >= strings.size()) {
+                Fail();
+                return empty;
+            }
+            return strings[index];
+        }
+
+        std::span<const uint8_t> Rest() { return Bytes(data.size() - pos); }
+
+        std::span<const uint8_t> Bytes(uint64_t _length) {
+            if (_length > data.size() - pos) {
+                Fail();
+                return {};
+            }
+
+            auto result = data.subspan(pos, _length);
+            pos += _length;
+            return result;
+        }
+
+        // Dynamic forms are written by their full FormID with no plugin name.
+        void Form(RE::TESForm*& _target) {
+            RE::FormID id = U32();
+            const auto& modname = String();
+            if (!resolver) {
+                _target = nullptr;
+                return;
+            }
+
+            resolver->Defer(std::addressof(_target), id, modname, modname.empty());
+        }
+
+        void StringTable(uint64_t _count) {
+            if (_count > data.size()) {
+                Fail();
+                return;
+            }
+
+            strings.reserve(_count);
+            for (uint64_t i = 0; i < _count && isGood; i++) {
+                auto length = Varint();
+                if (length > data.size() - pos) {
+                    Fail();
+                    return;
+                }
+                strings.emplace_back(reinterpret_cast<const char*>(data.data() + pos), length);
+                pos += length;
+            }
+        }
+
+    private:
+        std::span<const uint8_t> data;
+        size_t pos{0};
+        bool isGood{true};
+        std::vector<std::string> strings;
+        FormResolver* resolver{nullptr};
+
+        uint64_t Fail() {
+            isGood = false;
+            pos = data.size();
+            return 0U;
+        }
+    };
+
+    void WriteCommon(Writer& _writer, const Equipset& _equipset) {
+        _writer.String(_equipset.name);
+        _writer.Varint(_equipset.hotkey);
+        _writer.Varint((_equipset.modifier1 ? 1U : 0U) | (_equipset.modifier2 ? 2U : 0U) |
+                       (_equipset.modifier3 ? 4U : 0U));
+        _writer.Varint(static_cast<uint32_t>(_equipset.gesture));
+        _writer.Varint(_equipset.leader);
+        _writer.Varint(_equipset.layer);
+        _writer.Varint(_equipset.padMask);
+        _writer.Varint(_equipset.order);
+    }
+
+    void ReadCommon(Reader& _reader, Equipset& _equipset) {
+        _equipset.name = _reader.String();
+        _equipset.hotkey = _reader.U32();
+        auto modifier = _reader.U32();
+        _equipset.modifier1 = modifier & 1U;
+        _equipset.modifier2 = modifier & 2U;
+        _equipset.modifier3 = modifier & 4U;
+        _equipset.gesture = static_cast<Equipset::GESTURE>(std::min(_reader.U32(), 2U));
+        _equipset.leader = _reader.U32();
+        _equipset.layer = _reader.U32();
+        _equipset.padMask = _reader.U32();
+        _equipset.order = _reader.U32();
+    }
+
+    void WriteIcon(Writer& _writer, const WidgetIcon& _icon) {
+        _writer.Varint(_icon.enable);
+        _writer.String(_icon.type);
+        _writer.Zigzag(_icon.offsetX);
+        _writer.Zigzag(_icon.offsetY);
+    }
+
+    WidgetIcon ReadIcon(Reader& _reader) {
+        WidgetIcon result;
+        result.enable = _reader.Bool();
+        result.type = _reader.String();
+        result.offsetX = _reader.Zigzag();
+        result.offsetY = _reader.Zigzag();
+        return result;
+    }
+
+    void WriteText(Writer& _writer, const WidgetText& _text) {
+        _writer.Varint(_text.enable);
+        _writer.Varint(static_cast<uint32_t>(_text.align));
+        _writer.Zigzag(_text.offsetX);
+        _writer.Zigzag(_text.offsetY);
+    }
+
+    WidgetText ReadText(Reader& _reader) {
+        WidgetText result;
+        result.enable = _reader.Bool();
+        result.align = static_cast<WidgetText::ALIGN_TYPE>(std::min(_reader.U32(), 2U));
+        result.offsetX = _reader.Zigzag();
+        result.offsetY = _reader.Zigzag();
+        return result;
+    }
+
+    // DataWeapon and DataArmor share their field layout.
+    template <class T>
+    void WriteEnchanted(Writer& _writer, const T& _data) {
+        _writer.Varint(static_cast<uint32_t>(_data.type));
+        _writer.String(_data.name);
+        _writer.Varint(_data.enchNum);
+        _writer.String(_data.enchName);
+        _writer.Float(_data.tempVal);
+        _writer.Form(_data.form);
+    }
+
+    template <class T>
+    void ReadEnchanted(Reader& _reader, T& _out) {
+        _out.type = static_cast<Data::DATATYPE>(_reader.U32());
+        _out.name = _reader.String();
+        _out.enchNum = _reader.U32();
+        _out.enchName = _reader.String();
+        _out.tempVal = _reader.Float();
+        _reader.Form(_out.form);
+    }
+
+    // DataShout and DataPotion share their field layout.
+    template <class T>
+    void WritePlain(Writer& _writer, const T& _data) {
+        _writer.Varint(static_cast<uint32_t>(_data.type));
+        _writer.String(_data.name);
+        _writer.Form(_data.form);
+    }
+
+    template <class T>
+    void ReadPlain(Reader& _reader, T& _out) {
+        _out.type = static_cast<Data::DATATYPE>(_reader.U32());
+        _out.name = _reader.String();
+        _reader.Form(_out.form);
+    }
+
+    // Blobs hold the payload alone, so renaming or rebinding a set never writes a new one.
+    void WriteNormal(Writer& _writer, const NormalSet& _equipset) {
+        _writer.Varint((_equipset.equipSound ? 1U : 0U) | (_equipset.toggleEquip ? 2U : 0U) |
+                       (_equipset.reEquip ? 4U : 0U));
+        WriteIcon(_writer, _equipset.widgetIcon);
+        WriteText(_writer, _equipset.widgetName);
+        WriteText(_writer, _equipset.widgetHotkey);
+        WriteEnchanted(_writer, _equipset.lefthand);
+        WriteEnchanted(_writer, _equipset.righthand);
+        WritePlain(_writer, _equipset.shout);
+        _writer.Varint(_equipset.items.size());
+        for (const auto& item : _equipset.items) {
+            WriteEnchanted(_writer, item);
+        }
+    }
+
+    void ReadNormal(Reader& _reader, NormalSet& _equipset) {
+        _equipset.type = Equipset::TYPE::NORMAL;
+        auto flags = _reader.U32();
+        _equipset.equipSound = flags & 1U;
+        _equipset.toggleEquip = flags & 2U;
+        _equipset.reEquip = flags & 4U;
+        _equipset.widgetIcon = ReadIcon(_reader);
+        _equipset.widgetName = ReadText(_reader);
+        _equipset.widgetHotkey = ReadText(_reader);
+        ReadEnchanted(_reader, _equipset.lefthand);
+        ReadEnchanted(_reader, _equipset.righthand);
+        ReadPlain(_reader, _equipset.shout);
+
+        // Sized up front: the resolver keeps pointers into the items until Resolve.
+        _equipset.items.resize(_reader.Count());
+        for (auto& item : _equipset.items) {
+            ReadEnchanted(_reader, item);
+        }
+    }
+
+    // Auto potions are picked from the inventory again on load, so the pick is left out of the blob.
+    void WriteAutoPotion(Writer& _writer, const DataPotion& _data) {
+        if (_data.type == Data::DATATYPE::POTION_AUTO_HIGHEST || _data.type == Data::DATATYPE::POTION_AUTO_LOWEST) {
+            WritePlain(_writer, DataPotion(_data.type, _data.name, nullptr));
+        } else {
+            WritePlain(_writer, _data);
+        }
+    }
+
+    void WritePotion(Writer& _writer, const PotionSet& _equipset) {
+        _writer.Varint((_equipset.equipSound ? 1U : 0U) | (_equipset.calcDuration ? 2U : 0U));
+        WriteIcon(_writer, _equipset.widgetIcon);
+        WriteText(_writer, _equipset.widgetName);
+        WriteText(_writer, _equipset.widgetAmount);
+        WriteAutoPotion(_writer, _equipset.health);
+        WriteAutoPotion(_writer, _equipset.magicka);
+        WriteAutoPotion(_writer, _equipset.stamina);
+        _writer.Varint(_equipset.items.size());
+        for (const auto& item : _equipset.items) {
+            WritePlain(_writer, item);
+        }
+    }
+
+    void ReadPotion(Reader& _reader, PotionSet& _equipset) {
+        _equipset.type = Equipset::TYPE::POTION;
+        auto flags = _reader.U32();
+        _equipset.equipSound = flags & 1U;
+        _equipset.calcDuration = flags & 2U;
+        _equipset.widgetIcon = ReadIcon(_reader);
+        _equipset.widgetName = ReadText(_reader);
+        _equipset.widgetAmount = ReadText(_reader);
+        ReadPlain(_reader, _equipset.health);
+        ReadPlain(_reader, _equipset.magicka);
+        ReadPlain(_reader, _equipset.stamina);
+
+        // Sized up front: the resolver keeps pointers into the items until Resolve.
+        _equipset.items.resize(_reader.Count());
+        for (auto& item : _equipset.items) {
+            ReadPlain(_reader, item);
+        }
+    }
+
+    // Cycle progress is per-save state and goes into the cosave entry, so the blob hashes the same at any
+    // point of the cycle.
+    void WriteCycle(Writer& _writer, const CycleSet& _cycleset) {
+        _writer.Varint(_cycleset.cyclePersist ? 1U : 0U);
+        _writer.Float(_cycleset.cycleExpire);
+        _writer.Float(_cycleset.cycleReset);
+        WriteIcon(_writer, _cycleset.widgetIcon);
+        WriteText(_writer, _cycleset.widgetName);
+        WriteText(_writer, _cycleset.widgetHotkey);
+        _writer.Varint(_cycleset.items.size());
+        for (const auto& item : _cycleset.items) {
+            _writer.String(item);
+        }
+    }
+
+    void ReadCycle(Reader& _reader, CycleSet& _cycleset) {
+        _cycleset.type = Equipset::TYPE::CYCLE;
+        _cycleset.cyclePersist = _reader.Bool();
+        _cycleset.cycleExpire = _reader.Float();
+        _cycleset.cycleReset = _reader.Float();
+        _cycleset.widgetIcon = ReadIcon(_reader);
+        _cycleset.widgetName = ReadText(_reader);
+        _cycleset.widgetHotkey = ReadText(_reader);
+        _cycleset.items.resize(_reader.Count());
+        for (auto& item : _cycleset.items) {
+            item = _reader.String();
+        }
+    }
+
+    using Blob = std::shared_ptr<const std::vector<uint8_t>>;
+
+    // Key: blob hash. Kept across reverts, so loading another save that shares a set skips the disk.
+    std::unordered_map<uint64_t, Blob> library;
+    // Hashes confirmed present in the library directory, and those whose write is still queued. Guarded by
+    // storedLock alone: the writer thread confirms writes while a save holds libraryLock and waits on it.
+    std::unordered_set<uint64_t> storedHashes;
+    std::unordered_set<uint64_t> queuedHashes;
+    std::mutex storedLock;
+    // Hashes whose blob is missing or failed to decode. Their sets keep the reference, so saves carry it over
+    // untouched and restoring the file brings the set back.
+    std::unordered_set<uint64_t> damagedHashes;
+    // Recursive: loading a record creates sets, and creating a set with a widget materializes it.
+    std::recursive_mutex libraryLock;
+
+    // FNV-1a
+    uint64_t Hash(std::span<const uint8_t> _data) {
+        uint64_t result = 0xCBF29CE484222325ULL;
+        for (auto byte : _data) {
+            result ^= byte;
+            result *= 0x100000001B3ULL;
+        }
+        return result;
+    }
+
+    std::filesystem::path GetLibraryPath(uint64_t _hash) {
+        return library_path / fmt::format("{:016X}.bin", _hash);
+    }
+
+    Blob Intern(uint64_t _hash, std::vector<uint8_t>&& _data) {
+        auto [it, inserted] = library.try_emplace(_hash);
+        if (inserted) it->second = std::make_shared<const std::vector<uint8_t>>(std::move(_data));
+        return it->second;
+    }
+
+    bool IsStored(uint64_t _hash) {
+        std::lock_guard<std::mutex> guard(storedLock);
+        return storedHashes.contains(_hash);
+    }
+
+    bool HasQueued() {
+        std::lock_guard<std::mutex> guard(storedLock);
+        return !queuedHashes.empty();
+    }
+
+    // Returns true if the blob had to be queued for writing; it only counts as stored once the write landed.
+    bool Store(uint64_t _hash, const Blob& _blob) {
+        {
+            std::lock_guard<std::mutex> guard(storedLock);
+            if (storedHashes.contains(_hash) || queuedHashes.contains(_hash)) return false;
+
+            std::error_code ec;
+            if (std::filesystem::exists(GetLibraryPath(_hash), ec)) {
+                storedHashes.insert(_hash);
+                return false;
+            }
+
+            std::filesystem::create_directories(library_path, ec);
+            queuedHashes.insert(_hash);
+        }
+
+        FileWriter::GetSingleton()->Write(GetLibraryPath(_hash), std::string(_blob->begin(), _blob->end()),
+                                          [_hash](bool _isCommitted) {
+                                              std::lock_guard<std::mutex> guard(storedLock);
+                                              queuedHashes.erase(_hash);
+                                              if (_isCommitted) storedHashes.insert(_hash);
+                                          });
+        return true;
+    }
+
+    Blob Load(uint64_t _hash) {
+        if (auto it = library.find(_hash); it != library.end()) return it->second;
+
+        std::ifstream file(GetLibraryPath(_hash), std::ios::binary);
+        if (!file.is_open()) return nullptr;
+
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        if (Hash(data) != _hash) return nullptr;
+
+        {
+            std::lock_guard<std::mutex> guard(storedLock);
+            storedHashes.insert(_hash);
+        }
+        return Intern(_hash, std::move(data));
+    }
+
+    // Library sweep. Refs/<save>.refs lists the hashes each save references. A hash that leaves a list, or whose
+    // save is deleted, becomes a candidate and its blob is removed at the next save if no list names it by then;
+    // waiting one save means the save file that still referenced it has been replaced on disk.
+    const std::filesystem::path refs_path = library_path / "Refs";
+    constexpr std::string_view legacyRefs{"_legacy.refs"};
+    constexpr std::string_view unnamedRefs{"_unnamed.refs"};
+
+    // Key: refs file name
+    std::unordered_map<std::string, std::vector<uint64_t>> saveRefs;
+    std::unordered_set<uint64_t> sweepCandidates;
+    std::string saveName;
+    bool isRefsLoaded{false};
+    // Cleared when a list fails to write, since the lists on disk no longer cover every save.
+    std::atomic<bool> isSweepEnabled{true};
+
+    std::string GetRefsName(const std::string& _saveName) {
+        auto name = std::filesystem::path(_saveName).filename().string();
+        return name.empty() ? std::string(unnamedRefs) : name + ".refs";
+    }
+
+    std::vector<uint64_t> ReadRefs(const std::filesystem::path& _path) {
+        std::ifstream file(_path, std::ios::binary);
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        Reader reader(data);
+        std::vector<uint64_t> result(data.size() / 8);
+        for (auto& elem : result) {
+            elem = reader.Fixed64();
+        }
+        return result;
+    }
+
+    void WriteRefs(const std::string& _name, const std::vector<uint64_t>& _hashes) {
+        Writer writer;
+        for (auto hash : _hashes) {
+            writer.Fixed64(hash);
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(refs_path, ec);
+        FileWriter::GetSingleton()->Write(refs_path / _name, std::string(writer.body.begin(), writer.body.end()),
+                                          [](bool _isCommitted) {
+                                              if (!_isCommitted) isSweepEnabled.store(false);
+                                          });
+    }
+
+    // Saves made before the lists existed are unknown, so every blob already in the library is pinned for them.
+    void LoadRefs() {
+        if (isRefsLoaded) return;
+        isRefsLoaded = true;
+
+        std::error_code ec;
+        if (!std::filesystem::exists(refs_path, ec)) {
+            std::vector<uint64_t> pinned;
+            for (const auto& entry : std::filesystem::directory_iterator(library_path, ec)) {
+                if (entry.path().extension() != ".bin") continue;
+
+                auto stem = entry.path().stem().string();
+                uint64_t hash;
+                auto [ptr, err] = std::from_chars(stem.data(), stem.data() + stem.size(), hash, 16);
+                if (err == std::errc{} && ptr == stem.data() + stem.size()) pinned.push_back(hash);
+            }
+
+            std::ranges::sort(pinned);
+            WriteRefs(std::string(legacyRefs), pinned);
+            saveRefs.emplace(legacyRefs, std::move(pinned));
+            return;
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(refs_path, ec)) {
+            if (entry.path().extension() != ".refs") continue;
+            saveRefs[entry.path().filename().string()] = ReadRefs(entry.path());
+        }
+    }
+
+    // Returns true if the list changed and was queued for writing. Hashes it drops become sweep candidates.
+    bool UpdateRefs(const std::string& _name, std::vector<uint64_t> _hashes) {
+        auto& refs = saveRefs[_name];
+
+        // Saves without a known name share one list, which therefore only grows.
+        if (_name == unnamedRefs) _hashes.insert(_hashes.end(), refs.begin(), refs.end());
+
+        std::ranges::sort(_hashes);
+        auto [first, last] = std::ranges::unique(_hashes);
+        _hashes.erase(first, last);
+        if (refs == _hashes) return false;
+
+        std::ranges::set_difference(refs, _hashes, std::inserter(sweepCandidates, sweepCandidates.end()));
+        refs = std::move(_hashes);
+        WriteRefs(_name, refs);
+        return true;
+    }
+
+    void Sweep(const std::unordered_set<uint64_t>& _candidates) {
+        if (_candidates.empty() || !isSweepEnabled.load()) return;
+
+        std::unordered_set<uint64_t> referenced;
+        for (const auto& [name, refs] : saveRefs) {
+            referenced.insert(refs.begin(), refs.end());
+        }
+
+        uint32_t count = 0U;
+        {
+            std::lock_guard<std::mutex> guard(storedLock);
+            for (auto hash : _candidates) {
+                if (referenced.contains(hash) || queuedHashes.contains(hash)) continue;
+
+                std::error_code ec;
+                if (std::filesystem::remove(GetLibraryPath(hash), ec)) count++;
+                storedHashes.erase(hash);
+            }
+        }
+
+        if (count > 0) logger::info("Removed {} unreferenced equipsets from the library.", count);
+    }
+
+    // Index entry flags
+    constexpr uint64_t widgetVisibleFlag{1U};
+
+    // Reads the index entries of one type. The payloads stay in the library until each set is first used.
+    template <class T>
+    bool ReadSection(Reader& _reader, uint32_t _count, std::vector<std::unique_ptr<Equipset>>& _out) {
+        for (uint32_t i = 0; i < _count; i++) {
+            auto equipset = std::make_unique<T>();
+            equipset->payload = _reader.Fixed64();
+
+            // A blob whose library write had failed travels in the record; try to store it again.
+            auto inlined = _reader.Bytes(_reader.Varint());
+            if (!inlined.empty() && Hash(inlined) == equipset->payload) {
+                std::vector<uint8_t> data(inlined.begin(), inlined.end());
+                Store(equipset->payload, Intern(equipset->payload, std::move(data)));
+            }
+
+            ReadCommon(_reader, *equipset);
+            auto flags = _reader.U32();
+            equipset->isWidgetVisible = flags & widgetVisibleFlag;
+            if constexpr (std::is_same_v<T, CycleSet>) {
+                equipset->cycleIndex = _reader.U32();
+                equipset->isCycleInit = _reader.Bool();
+            }
+            if (!_reader.IsGood()) return false;
+
+            _out.push_back(std::move(equipset));
+        }
+        return true;
+    }
+
+    struct CacheEntry {
+        uint32_t revision{0U};
+        uint64_t hash{0U};
+        Blob blob;
+    };
+
+    constexpr uint64_t compressedFlag{1U};
+    // Guards the decompression buffer against a corrupted raw size.
+    constexpr uint64_t maxRawSize{64U * 1024U * 1024U};
+
+    // Key: equipset handle
+    std::unordered_map<uint32_t, CacheEntry> blobCache;
+    Cosave::SaveStats lastSaveStats;
+
+    const CacheEntry& Encode(Equipset* _equipset, Cosave::SaveStats& _stats) {
+        auto revision = _equipset->revision.load(std::memory_order_relaxed);
+        auto& entry = blobCache[_equipset->handle];
+        if (revision != 0U && entry.revision == revision && entry.blob) return entry;
+
+        Writer writer;
+        if (_equipset->type == Equipset::TYPE::NORMAL) {
+            WriteNormal(writer, *static_cast<NormalSet*>(_equipset));
+        } else if (_equipset->type == Equipset::TYPE::POTION) {
+            WritePotion(writer, *static_cast<PotionSet*>(_equipset));
+        } else {
+            WriteCycle(writer, *static_cast<CycleSet*>(_equipset));
+        }
+
+        auto data = writer.Finish();
+        _stats.encodedCount++;
+        _stats.encodedBytes += data.size();
+
+        entry.revision = revision;
+        entry.hash = Hash(data);
+        entry.blob = Intern(entry.hash, std::move(data));
+        return entry;
+    }
+
+    bool HasWidget(Equipset* _equipset) {
+        if (_equipset->type == Equipset::TYPE::NORMAL) {
+            auto equipset = static_cast<NormalSet*>(_equipset);
+            return equipset->widgetIcon.enable || equipset->widgetName.enable || equipset->widgetHotkey.enable;
+        } else if (_equipset->type == Equipset::TYPE::POTION) {
+            auto equipset = static_cast<PotionSet*>(_equipset);
+            return equipset->widgetIcon.enable || equipset->widgetName.enable || equipset->widgetAmount.enable;
+        } else {
+            auto cycleset = static_cast<CycleSet*>(_equipset);
+            return cycleset->widgetIcon.enable || cycleset->widgetName.enable || cycleset->widgetHotkey.enable;
+        }
+    }
+
+    // Moves everything but the index fields, which may have changed since the blob was written.
+    void TakePayload(NormalSet& _from, NormalSet& _to) {
+        _to.equipSound = _from.equipSound;
+        _to.toggleEquip = _from.toggleEquip;
+        _to.reEquip = _from.reEquip;
+        _to.widgetIcon = std::move(_from.widgetIcon);
+        _to.widgetName = std::move(_from.widgetName);
+        _to.widgetHotkey = std::move(_from.widgetHotkey);
+        _to.lefthand = std::move(_from.lefthand);
+        _to.righthand = std::move(_from.righthand);
+        _to.shout = std::move(_from.shout);
+        _to.items = std::move(_from.items);
+    }
+
+    void TakePayload(PotionSet& _from, PotionSet& _to) {
+        _to.equipSound = _from.equipSound;
+        _to.calcDuration = _from.calcDuration;
+        _to.widgetIcon = std::move(_from.widgetIcon);
+        _to.widgetName = std::move(_from.widgetName);
+        _to.widgetAmount = std::move(_from.widgetAmount);
+        _to.health = std::move(_from.health);
+        _to.magicka = std::move(_from.magicka);
+        _to.stamina = std::move(_from.stamina);
+        _to.items = std::move(_from.items);
+        _to.AssignAutoPotion();
+    }
+
+    void TakePayload(CycleSet& _from, CycleSet& _to) {
+        _to.cyclePersist = _from.cyclePersist;
+        _to.cycleExpire = _from.cycleExpire;
+        _to.cycleReset = _from.cycleReset;
+        _to.widgetIcon = std::move(_from.widgetIcon);
+        _to.widgetName = std::move(_from.widgetName);
+        _to.widgetHotkey = std::move(_from.widgetHotkey);
+        _to.items = std::move(_from.items);
+        if (_to.cycleIndex >= _to.items.size()) _to.cycleIndex = 0U;
+    }
+
+    template <class T, class Func>
+    std::unique_ptr<Equipset> DecodePayload(const Blob& _blob, Func _read, FormResolver& _resolver) {
+        FormResolver resolver;
+        Reader reader(*_blob, std::addressof(resolver));
+        reader.StringTable(reader.Varint());
+
+        auto decoded = std::make_unique<T>();
+        _read(reader, *decoded);
+        if (!reader.IsGood()) return nullptr;
+
+        _resolver.Merge(resolver);
+        return decoded;
+    }
+}
+
+namespace Cosave {
+    bool WriteEquipsets(SKSE::SerializationInterface* serde) {
+        auto manager = EquipsetManager::GetSingleton();
+        if (!manager || !serde) return false;
+
+        std::lock_guard<std::recursive_mutex> guard(libraryLock);
+        auto start = std::chrono::steady_clock::now();
+        SaveStats stats;
+        Writer header;
+        Writer sections;
+        std::unordered_set<uint32_t> alive;
+
+        struct Entry {
+            Equipset* equipset;
+            uint64_t hash;
+            bool isWidgetVisible;
+        };
+        std::vector<Entry> entries;
+        entries.reserve(manager->equipsetVec.size());
+
+        // One section per type, so the reader never has to branch on a type tag.
+        for (auto type : {Equipset::TYPE::NORMAL, Equipset::TYPE::POTION, Equipset::TYPE::CYCLE}) {
+            uint32_t count = 0U;
+            for (auto elem : manager->equipsetVec) {
+                if (elem->type != type) continue;
+
+                // A set that was never used since loading still has its blob in the library.
+                entries.push_back({elem, elem->payload, elem->isWidgetVisible});
+                auto& entry = entries.back();
+                if (elem->IsMaterialized()) {
+                    const auto& cached = Encode(elem, stats);
+                    if (Store(cached.hash, cached.blob)) stats.storedCount++;
+                    entry.hash = cached.hash;
+                    entry.isWidgetVisible = HasWidget(elem);
+                }
+                alive.insert(elem->handle);
+                count++;
+            }
+            header.Varint(count);
+            stats.totalCount += count;
+        }
+
+        std::erase_if(blobCache, [&](const auto& _elem) { return !alive.contains(_elem.first); });
+
+        // Candidates left by earlier saves are checked against every list, this save's new one included.
+        LoadRefs();
+        auto candidates = std::exchange(sweepCandidates, {});
+        std::vector<uint64_t> hashes;
+        hashes.reserve(entries.size());
+        for (const auto& entry : entries) {
+            if (entry.hash != 0U) hashes.push_back(entry.hash);
+        }
+        auto isRefsQueued = UpdateRefs(GetRefsName(std::exchange(saveName, {})), std::move(hashes));
+        Sweep(candidates);
+
+        // The record must never reference a blob that is not on disk; one whose write failed goes in the record.
+        if (isRefsQueued || HasQueued()) FileWriter::GetSingleton()->Flush();
+
+        for (const auto& entry : entries) {
+            sections.Fixed64(entry.hash);
+
+            auto it = IsStored(entry.hash) ? library.end() : library.find(entry.hash);
+            if (it != library.end()) {
+                sections.Varint(it->second->size());
+                sections.body.insert(sections.body.end(), it->second->begin(), it->second->end());
+                stats.inlinedCount++;
+            } else {
+                sections.Varint(0U);
+            }
+
+            WriteCommon(sections, *entry.equipset);
+            sections.Varint(entry.isWidgetVisible ? widgetVisibleFlag : 0U);
+            if (entry.equipset->type == Equipset::TYPE::CYCLE) {
+                auto cycleset = static_cast<CycleSet*>(entry.equipset);
+                sections.Varint(cycleset->cycleIndex);
+                sections.Varint(cycleset->isCycleInit);
+            }
+        }
+
+        auto body = sections.Finish();
+        header.body.insert(header.body.end(), body.begin(), body.end());
+        stats.rawBytes = header.body.size();
+
+        // Compressed output is only kept when it is actually smaller.
+        Writer prefix;
+        std::vector<uint8_t> packed;
+        auto config = ConfigHandler::GetSingleton();
+        if (config && config->Settings.compressCosave) {
+            auto compressStart = std::chrono::steady_clock::now();
+            packed = Compression::Compress(header.body);
+            auto compressElapsed = std::chrono::steady_clock::now() - compressStart;
+            stats.compressElapsed = std::chrono::duration_cast<std::chrono::microseconds>(compressElapsed).count();
+        }
+
+        bool isCompressed = !packed.empty() && packed.size() < header.body.size();
+        const auto& payload = isCompressed ? packed : header.body;
+        prefix.Varint(isCompressed ? compressedFlag : 0U);
+        if (isCompressed) prefix.Varint(header.body.size());
+        serde->WriteRecordData(prefix.body.data(), static_cast<uint32_t>(prefix.body.size()));
+        serde->WriteRecordData(payload.data(), static_cast<uint32_t>(payload.size()));
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        stats.writtenBytes = prefix.body.size() + payload.size();
+        stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        lastSaveStats = stats;
+
+        logger::info("Equipset saved: {}/{} re-encoded, {} added to library, {} kept in the record, {} bytes encoded, "
+                     "{} -> {} bytes written (compression {}us), {}us.",
+                     stats.encodedCount, stats.totalCount, stats.storedCount, stats.inlinedCount, stats.encodedBytes,
+                     stats.rawBytes, stats.writtenBytes, stats.compressElapsed, stats.elapsed);
+        if (stats.inlinedCount > 0) {
+            logger::warn("{} equipsets could not be written to the library and were saved in the record.",
+                         stats.inlinedCount);
+        }
+        return true;
+    }
+
+    bool ReadEquipsets(SKSE::SerializationInterface* serde, uint32_t _size) {
+        auto manager = EquipsetManager::GetSingleton();
+        if (!manager || !serde) return false;
+
+        std::lock_guard<std::recursive_mutex> guard(libraryLock);
+        std::vector<uint8_t> data(_size);
+        if (serde->ReadRecordData(data.data(), _size) != _size) {
+            logger::error("Equipset record is truncated.");
+            return false;
+        }
+
+        Reader prefix(data);
+        auto flags = prefix.Varint();
+        auto rawSize = flags & compressedFlag ? prefix.Varint() : 0U;
+        auto rest = prefix.Rest();
+        if (!prefix.IsGood()) {
+            logger::error("Equipset record is corrupted.");
+            return false;
+        }
+
+        std::vector<uint8_t> raw;
+        if (!(flags & compressedFlag)) {
+            raw.assign(rest.begin(), rest.end());
+        } else if (rawSize > maxRawSize || !Compression::Decompress(rest, rawSize, raw)) {
+            logger::error("Failed to decompress equipset record.");
+            return false;
+        }
+
+        Reader reader(raw);
+        auto normalCount = reader.U32();
+        auto potionCount = reader.U32();
+        auto cycleCount = reader.U32();
+        reader.StringTable(reader.Varint());
+
+        std::vector<std::unique_ptr<Equipset>> equipsets;
+        bool result = reader.IsGood() && ReadSection<NormalSet>(reader, normalCount, equipsets) &&
+                      ReadSection<PotionSet>(reader, potionCount, equipsets) &&
+                      ReadSection<CycleSet>(reader, cycleCount, equipsets);
+
+        // The sets that could be read move into the manager; their forms resolve when they materialize.
+        for (auto& elem : equipsets) {
+            if (elem->type == Equipset::TYPE::NORMAL) {
+                manager->Create(std::move(*static_cast<NormalSet*>(elem.get())), false);
+            } else if (elem->type == Equipset::TYPE::POTION) {
+                manager->Create(std::move(*static_cast<PotionSet*>(elem.get())), false);
+            } else if (elem->type == Equipset::TYPE::CYCLE) {
+                manager->Create(std::move(*static_cast<CycleSet*>(elem.get())), false);
+            }
+        }
+
+        if (!result) {
+            logger::error("Equipset record is corrupted; loaded what could be read.");
+            return false;
+        }
+
+        logger::info("Equipset loaded.");
+        return true;
+    }
+
+    void Materialize(Equipset* _equipset) { Materialize(std::span<Equipset* const>(&_equipset, 1)); }
+
+    void Materialize(std::span<Equipset* const> _equipsets) {
+        std::lock_guard<std::recursive_mutex> guard(libraryLock);
+
+        struct Decoded {
+            Equipset* equipset;
+            uint64_t hash;
+            Blob blob;
+            std::unique_ptr<Equipset> payload;
+        };
+        std::vector<Decoded> decoded;
+        FormResolver resolver;
+
+        for (auto elem : _equipsets) {
+            if (!elem || elem->IsMaterialized()) continue;
+
+            // The reference is only dropped once its payload decoded; a failed set stays pending.
+            auto hash = elem->payload;
+            if (damagedHashes.contains(hash)) continue;
+
+            auto blob = Load(hash);
+            std::unique_ptr<Equipset> payload;
+            if (blob) {
+                if (elem->type == Equipset::TYPE::NORMAL) {
+                    payload = DecodePayload<NormalSet>(blob, ReadNormal, resolver);
+                } else if (elem->type == Equipset::TYPE::POTION) {
+                    payload = DecodePayload<PotionSet>(blob, ReadPotion, resolver);
+                } else {
+                    payload = DecodePayload<CycleSet>(blob, ReadCycle, resolver);
+                }
+            }
+
+            if (!payload) {
+                damagedHashes.insert(hash);
+                logger::error("Equipset {} is missing or damaged in the library; its reference is kept.", elem->name);
+                continue;
+            }
+
+            decoded.push_back({elem, hash, std::move(blob), std::move(payload)});
+        }
+
+        // One resolve pass for every set decoded here; auto potions are picked once their forms are known.
+        resolver.Resolve();
+        for (auto& [equipset, hash, blob, payload] : decoded) {
+            equipset->payload = 0U;
+            if (equipset->type == Equipset::TYPE::NORMAL) {
+                TakePayload(*static_cast<NormalSet*>(payload.get()), *static_cast<NormalSet*>(equipset));
+            } else if (equipset->type == Equipset::TYPE::POTION) {
+                TakePayload(*static_cast<PotionSet*>(payload.get()), *static_cast<PotionSet*>(equipset));
+            } else {
+                TakePayload(*static_cast<CycleSet*>(payload.get()), *static_cast<CycleSet*>(equipset));
+            }
+
+            // The blob still describes the set, so the next save can reuse it without re-encoding.
+            auto& entry = blobCache[equipset->handle];
+            entry.revision = equipset->revision.load(std::memory_order_relaxed);
+            entry.hash = hash;
+            entry.blob = blob;
+        }
+    }
+
+    void SetSaveName(std::string_view _name) {
+        std::lock_guard<std::recursive_mutex> guard(libraryLock);
+        saveName = _name;
+    }
+
+    void DeleteSave(std::string_view _name) {
+        std::lock_guard<std::recursive_mutex> guard(libraryLock);
+        LoadRefs();
+
+        auto name = GetRefsName(std::string(_name));
+        auto it = saveRefs.find(name);
+        if (it == saveRefs.end()) return;
+
+        sweepCandidates.insert(it->second.begin(), it->second.end());
+        saveRefs.erase(it);
+
+        // A queued write of the list would bring it back.
+        FileWriter::GetSingleton()->Flush();
+        std::error_code ec;
+        std::filesystem::remove(refs_path / name, ec);
+    }
+
+    const SaveStats& GetLastSaveStats() { return lastSaveStats; }
+
+    void ClearCache() {
+        std::lock_guard<std::recursive_mutex> guard(libraryLock);
+        blobCache.clear();
+        damagedHashes.clear();
+    }
+}
\ No newline at end of file
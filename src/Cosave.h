@@ -0,0 +1,50 @@
+#pragma once
+
+// Binary equipset record for the SKSE cosave.
+//
+// Layout (all integers are LEB128 varints, signed ones zigzag-encoded, floats and hashes raw little-endian):
+//   prefix:  flags; bit 0 marks the rest as Compression-packed, followed by its unpacked size
+//   header:  normal count, potion count, cycle count
+//   strings: string count, strings (length + bytes), shared by the index entries
+//   entries: grouped by type in header order, each an index of
+//            payload hash (8 bytes), inline blob length (0 if the blob is in the library) and bytes,
+//            common fields (name, chord, layer, order), flags (bit 0 widget visible),
+//            and for cycle sets the cycle index and init flag
+//   blob:    string count, strings (length + bytes), then the payload fields; no index fields, cycle progress
+//            or auto-picked potions, so a blob only changes when the set's contents do
+//
+// Blobs live once in the on-disk library under Data/SKSE/Plugins/UIHS/Library, named by their hash, so saves
+// that share an equipset share its blob. Loading only decodes the index; a set's blob is read and its forms
+// resolved on first use (see Equipset::Materialize). Library/Refs lists the hashes each save references, and
+// blobs no list names are swept at save time.
+// A blob is only referenced once its library write is confirmed; if the write failed it is carried inline.
+class Equipset;
+
+namespace Cosave {
+    inline constexpr uint32_t EquipsetRecord{_byteswap_ulong('HSEB')};
+    inline constexpr uint32_t EquipsetVersion{1U};
+
+    struct SaveStats {
+        uint32_t encodedCount{0U};
+        uint32_t totalCount{0U};
+        uint32_t storedCount{0U};  // blobs newly written to the library
+        uint32_t inlinedCount{0U};  // blobs carried in the record because their library write failed
+        size_t encodedBytes{0};
+        size_t rawBytes{0};  // record size before compression
+        size_t writtenBytes{0};
+        int64_t compressElapsed{0};  // microseconds
+        int64_t elapsed{0};  // microseconds
+    };
+
+    bool WriteEquipsets(SKSE::SerializationInterface* serde);
+    bool ReadEquipsets(SKSE::SerializationInterface* serde, uint32_t _size);
+    void Materialize(Equipset* _equipset);
+    // Decodes every pending set in one pass, resolving all their form references together.
+    void Materialize(std::span<Equipset* const> _equipsets);
+    // Names the save the next WriteEquipsets belongs to, for the library sweep (SKSE kSaveGame).
+    void SetSaveName(std::string_view _name);
+    // Releases the library blobs a deleted save referenced (SKSE kDeleteGame).
+    void DeleteSave(std::string_view _name);
+    const SaveStats& GetLastSaveStats();
+    void ClearCache();
+}
\ No newline at end of file
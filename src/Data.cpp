@@ -3,290 +3,161 @@
 #include "Config.h"
 #include "Actor.h"
 #include "Translate.h"
-#include "Utility.h"
-
-DataWeapon::DataWeapon() {
-    auto ts = Translator::GetSingleton();
-    if (!ts) logger::error("Failed to get Translator.");
-
-    type = DATATYPE::NOTHING;
-    name = TRANSLATE("_NOTHING");
-    enchNum = 0;
-    enchName = Extra::ENCHNONE;
-    tempVal = 0.0f;
-    form = nullptr;
+#include "InventorySnapshot.h"
+
+ItemCatalog::Row ItemCatalog::Add(Data::DATATYPE _type, std::string_view _name, RE::TESForm* _form,
+                                  uint32_t _enchNum, std::string_view _enchName, float _tempVal) {
+    type.push_back(_type);
+    name.push_back(Intern(_name));
+    enchNum.push_back(_enchNum);
+    enchName.push_back(Intern(_enchName));
+    tempVal.push_back(_tempVal);
+    form.push_back(_form);
+    return static_cast<Row>(type.size() - 1);
 }
 
-std::string DataWeapon::Pack() {
-    std::string result;
-
-    auto file = form ? form->GetFile(0) : nullptr;
-    auto modname = file ? file->GetFilename() : ""sv;
+uint32_t ItemCatalog::Intern(std::string_view _value) {
+    auto it = poolMap.find(_value);
+    if (it != poolMap.end()) return it->second;
 
-    result += std::to_string(static_cast<uint32_t>(type)) + Utility::delimiter;
-    result += name + Utility::delimiter;
-    result += std::to_string(enchNum) + Utility::delimiter;
-    result += enchName + Utility::delimiter;
-    result += std::to_string(tempVal) + Utility::delimiter;
-    result += form ? std::to_string(form->GetLocalFormID()) : "0";
-    result += Utility::delimiter;
-    result += modname;
-    result += Utility::delimiter;
-
-    return result;
+    auto index = static_cast<uint32_t>(pool.size());
+    const auto& stored = pool.emplace_back(_value);
+    poolMap.emplace(stored, index);
+    return index;
 }
 
-
-DataWeapon DataWeapon::Unpack(const std::string& _packed) {
-    std::vector<std::string> dataVec = Utility::Split(_packed, Utility::delimiter);
-
-    assert(dataVec.size() == 7);
-
-    DataWeapon result;
-    result.type = static_cast<Data::DATATYPE>(std::stoi(dataVec[0]));
-    result.name = dataVec[1];
-    result.enchNum = std::stoi(dataVec[2]);
-    result.enchName = dataVec[3];
-    result.tempVal = std::stof(dataVec[4]);
-
-    RE::FormID id = std::stoll(dataVec[5]);
-    auto modname = dataVec[6];
-    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
-    auto form = TESDataHandler ? TESDataHandler->LookupForm(id, modname) : nullptr;
-    result.form = form;
-
-    return result;
+DataWeapon ItemCatalog::GetWeapon(Row _row) const {
+    return DataWeapon(type[_row], GetName(_row), enchNum[_row], GetEnchName(_row), tempVal[_row], form[_row]);
 }
 
-DataShout::DataShout() {
-    auto ts = Translator::GetSingleton();
-    if (!ts) logger::error("Failed to get Translator.");
-
-    type = DATATYPE::NOTHING;
-    name = TRANSLATE("_NOTHING");
-    form = nullptr;
+DataShout ItemCatalog::GetShout(Row _row) const {
+    return DataShout(type[_row], GetName(_row), form[_row]);
 }
 
-std::string DataShout::Pack() {
-    std::string result;
-
-    auto file = form ? form->GetFile(0) : nullptr;
-    auto modname = file ? file->GetFilename() : ""sv;
-
-    result += std::to_string(static_cast<uint32_t>(type)) + Utility::delimiter;
-    result += name + Utility::delimiter;
-    result += form ? std::to_string(form->GetLocalFormID()) : "0";
-    result += Utility::delimiter;
-    result += modname;
-    result += Utility::delimiter;
-
-    return result;
+DataArmor ItemCatalog::GetArmor(Row _row) const {
+    return DataArmor(type[_row], GetName(_row), enchNum[_row], GetEnchName(_row), tempVal[_row], form[_row]);
 }
 
-DataShout DataShout::Unpack(const std::string& _packed) {
-    std::vector<std::string> dataVec = Utility::Split(_packed, Utility::delimiter);
-
-    assert(dataVec.size() == 4);
-
-    DataShout result;
-    result.type = static_cast<Data::DATATYPE>(std::stoi(dataVec[0]));
-    result.name = dataVec[1];
-
-    RE::FormID id = std::stoll(dataVec[2]);
-    auto modname = dataVec[3];
-    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
-    auto form = TESDataHandler ? TESDataHandler->LookupForm(id, modname) : nullptr;
-    result.form = form;
-
-    return result;
+DataPotion ItemCatalog::GetPotion(Row _row) const {
+    return DataPotion(type[_row], GetName(_row), form[_row]);
 }
 
-DataArmor::DataArmor() {
-    type = DATATYPE::NOTHING;
-    name = "";
-    enchNum = 0;
-    enchName = Extra::ENCHNONE;
-    tempVal = 0.0f;
-    form = nullptr;
-}
+// Enchantment columns of a gathered item; an enchantment on the extra list wins over the base one.
+static std::pair<uint32_t, std::string> GetEnchColumns(const RE::TESBoundObject* _object,
+                                                      const RE::EnchantmentItem* _enchantment) {
+    if (!_enchantment) return {Extra::GetEnchNum(_object, nullptr), Extra::GetEnchName(_object, nullptr)};
 
-std::string DataArmor::Pack() {
-    std::string result;
-
-    auto file = form ? form->GetFile(0) : nullptr;
-    auto modname = file ? file->GetFilename() : ""sv;
-
-    result += std::to_string(static_cast<uint32_t>(type)) + Utility::delimiter;
-    result += name + Utility::delimiter;
-    result += std::to_string(enchNum) + Utility::delimiter;
-    result += enchName + Utility::delimiter;
-    result += std::to_string(tempVal) + Utility::delimiter;
-    result += form ? std::to_string(form->GetLocalFormID()) : "0";
-    result += Utility::delimiter;
-    result += modname;
-    result += Utility::delimiter;
-
-    return result;
+    return {static_cast<uint32_t>(_enchantment->effects.size()), _enchantment->GetName()};
 }
 
-DataArmor DataArmor::Unpack(const std::string& _packed) {
-    std::vector<std::string> dataVec = Utility::Split(_packed, Utility::delimiter);
-
-    assert(dataVec.size() == 7);
-
-    DataArmor result;
-    result.type = static_cast<Data::DATATYPE>(std::stoi(dataVec[0]));
-    result.name = dataVec[1];
-    result.enchNum = std::stoi(dataVec[2]);
-    result.enchName = dataVec[3];
-    result.tempVal = std::stof(dataVec[4]);
-
-    RE::FormID id = std::stoll(dataVec[5]);
-    auto modname = dataVec[6];
-    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
-    auto form = TESDataHandler ? TESDataHandler->LookupForm(id, modname) : nullptr;
-    result.form = form;
-
-    return result;
-}
+void DataHandler::Init() {
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return;
 
-DataPotion::DataPotion() {
     auto ts = Translator::GetSingleton();
-    if (!ts) logger::error("Failed to get Translator.");
-
-    type = DATATYPE::NOTHING;
-    name = TRANSLATE("_NOTHING");
-    form = nullptr;
-}
-
-std::string DataPotion::Pack() {
-    std::string result;
-
-    auto file = form ? form->GetFile(0) : nullptr;
-    auto modname = file ? file->GetFilename() : ""sv;
-
-    result += std::to_string(static_cast<uint32_t>(type)) + Utility::delimiter;
-    result += name + Utility::delimiter;
-    if (form) result += form->IsDynamicForm() ? std::to_string(form->GetFormID()) : std::to_string(form->GetLocalFormID());
-    else result += "0";
-    result += Utility::delimiter;
-    result += modname;
-    result += Utility::delimiter;
+    if (!ts) return;
 
-    return result;
-}
+    auto task = SKSE::GetTaskInterface();
+    if (!task) {
+        logger::error("Failed to get task interface.");
+        return;
+    }
 
-DataPotion DataPotion::Unpack(const std::string& _packed) {
-    std::vector<std::string> dataVec = Utility::Split(_packed, Utility::delimiter);
+    // Settings, translations and the effect table are changed from the GUI, so the worker gets copies.
+    auto source = std::make_shared<Source>();
+    source->favorOnly = config->Settings.favorOnly;
+    source->nothing = TRANSLATE("_NOTHING");
+    source->unequip = TRANSLATE("_UNEQUIP");
+    source->autoHighest = TRANSLATE("_AUTO_HIGHEST");
+    source->autoLowest = TRANSLATE("_AUTO_LOWEST");
 
-    assert(dataVec.size() == 4);
+    source->potionEffect = config->potionEffectMap;
 
-    DataPotion result;
-    result.type = static_cast<Data::DATATYPE>(std::stoi(dataVec[0]));
-    result.name = dataVec[1];
+    auto generation = requested.fetch_add(1U) + 1U;
+    task->AddTask([this, source, generation]() {
+        // Superseded by a newer request or by Clear() before it got to run.
+        if (generation != requested.load()) return;
 
-    RE::FormID id = std::stoll(dataVec[2]);
-    auto modname = dataVec[3];
-    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
-    auto form = TESDataHandler ? TESDataHandler->LookupForm(id, modname) : nullptr;
-    result.form = form;
+        GatherItem(*source);
+        GatherMagic(*source);
 
-    return result;
+        std::thread([this, source, generation]() { Publish(Build(*source), generation); }).detach();
+    });
 }
 
-void DataHandler::Init() {
-    Clear();
-    InitWeapon();
-    InitShout();
-    InitArmor();
-    InitPotion();
+void DataHandler::Clear() {
+    std::lock_guard<std::mutex> lock(publishLock);
+    auto generation = requested.fetch_add(1U) + 1U;
+    lists.store(std::make_shared<const ItemLists>());
+    published.store(generation);
 }
 
-void DataHandler::Clear() {
-    weapon_left.clear();
-    weapon_right.clear();
-    shout.clear();
-    armor.clear();
-    potion.clear();
-    potion_health.clear();
-    potion_magicka.clear();
-    potion_stamina.clear();
+void DataHandler::Publish(std::shared_ptr<const ItemLists> _lists, uint32_t _generation) {
+    std::lock_guard<std::mutex> lock(publishLock);
+    // A build that finishes after a newer one, or after Clear(), is dropped.
+    if (_generation <= published.load()) return;
+
+    lists.store(std::move(_lists));
+    published.store(_generation);
 }
 
-void DataHandler::InitWeapon() {
+void DataHandler::GatherItem(Source& _source) {
     auto player = RE::PlayerCharacter::GetSingleton();
     if (!player || !player->IsInitialized()) return;
 
-    auto config = ConfigHandler::GetSingleton();
-    if (!config) return;
-    
-    auto ts = Translator::GetSingleton();
-    if (!ts) return;
+    auto snapshot = InventorySnapshot::GetSingleton();
+    if (!snapshot) return;
 
-    bool favorOnly = config->Settings.favorOnly;
-    std::vector<Data::DATATYPE> type;
-    std::vector<std::string> name;
-    std::vector<uint32_t> enchNum;
-    std::vector<std::string> enchName;
-    std::vector<float> tempVal;
-    std::vector<RE::TESForm*> form;
-
-    for (int i = 0; i < 2; i++) {
-        Data::DATATYPE _type = i == 0 ? Data::DATATYPE::NOTHING : Data::DATATYPE::UNEQUIP;
-        std::string _name = i == 0 ? TRANSLATE("_NOTHING") : TRANSLATE("_UNEQUIP");
-        type.push_back(_type);
-        name.push_back(_name);
-        enchNum.push_back(0);
-        enchName.push_back(Extra::ENCHNONE);
-        tempVal.push_back(0.0f);
-        form.push_back(nullptr);
-    }
+    bool favorOnly = _source.favorOnly;
 
-    auto inv = player->GetInventory();
+    const auto& inv = snapshot->Get();
     for (const auto& [item, data] : inv) {
         const auto& [numItem, entry] = data;
         if (numItem < 1) continue;
 
+        auto extraLists = entry->extraLists;
         if (item->Is(RE::FormType::Weapon, RE::FormType::Armor)) {
+            // Shields go with the weapons, every other armor to its own list.
             auto armor = item->As<RE::TESObjectARMO>();
-            if (armor && !armor->IsShield()) continue;
+            bool isArmor = armor && !armor->IsShield();
+            auto& list = isArmor ? _source.armor : _source.weapon;
 
             uint32_t numExtra = 0;
-
-            auto extraLists = entry->extraLists;
             if (extraLists) {
                 for (auto& _xList : *extraLists) {
                     ++numExtra;
                     if (favorOnly && !Extra::IsFavorited(_xList)) continue;
 
-                    type.push_back(Data::DATATYPE::WEAP);
-                    name.push_back(item->GetName());
-                    enchNum.push_back(Extra::GetEnchNum(item, _xList));
-                    enchName.push_back(Extra::GetEnchName(item, _xList));
-                    tempVal.push_back(Extra::GetTempValue(_xList));
-                    form.push_back(item->As<RE::TESForm>());
+                    list.push_back({item, Extra::GetEnchantment(_xList), Extra::GetTempValue(_xList)});
                 }
             }
 
-            if (favorOnly) continue;
+            if (favorOnly || numExtra >= static_cast<uint32_t>(numItem)) continue;
 
-            if (numExtra != numItem) {
-                type.push_back(Data::DATATYPE::WEAP);
-                name.push_back(item->GetName());
-                enchNum.push_back(Extra::GetEnchNum(item, nullptr));
-                enchName.push_back(Extra::GetEnchName(item, nullptr));
-                tempVal.push_back(0.0f);
-                form.push_back(item->As<RE::TESForm>());
-            }
+            // Plain copies are identical; weapons list them once, armor once per copy.
+            list.push_back({item, nullptr, 0.0f, isArmor ? static_cast<uint32_t>(numItem) - numExtra : 1U});
         } else if (item->Is(RE::FormType::Light)) {
-            type.push_back(Data::DATATYPE::WEAP);
-            name.push_back(item->GetName());
-            enchNum.push_back(0);
-            enchName.push_back(Extra::ENCHNONE);
-            tempVal.push_back(0.0f);
-            form.push_back(item->As<RE::TESForm>());
+            _source.weapon.push_back({item});
+        } else if (item->Is(RE::FormType::AlchemyItem)) {
+            uint32_t count = favorOnly ? 0U : 1U;
+            if (extraLists) {
+                for (auto& _xList : *extraLists) {
+                    if (favorOnly && !Extra::IsFavorited(_xList)) continue;
+
+                    ++count;
+                }
+            }
+
+            if (count > 0) _source.potion.push_back({item, nullptr, 0.0f, count});
         }
     }
+}
+
+void DataHandler::GatherMagic(Source& _source) {
+    auto player = RE::PlayerCharacter::GetSingleton();
+    if (!player || !player->IsInitialized()) return;
+
+    bool favorOnly = _source.favorOnly;
 
     std::vector<RE::SpellItem*> allSpell;
 
@@ -315,95 +186,14 @@ void DataHandler::InitWeapon() {
     }
 
     for (auto spell : allSpell) {
+        if (favorOnly && !Extra::IsMagicFavorited(spell)) continue;
+
         auto spellType = spell->GetSpellType();
         if (spellType == RE::MagicSystem::SpellType::kSpell) {
-            if (favorOnly && !Extra::IsMagicFavorited(spell)) continue;
-
-            type.push_back(Data::DATATYPE::SPELL);
-            name.push_back(spell->GetName());
-            enchNum.push_back(0);
-            enchName.push_back(Extra::ENCHNONE);
-            tempVal.push_back(0.0f);
-            form.push_back(spell->As<RE::TESForm>());
-        }
-    }
-
-    for (int i = 0; i < type.size(); i++) {
-        DataWeapon data(type[i], name[i], enchNum[i], enchName[i], tempVal[i], form[i]);
-        weapon_left.push_back(data);
-    }
-    for (int i = 0; i < type.size(); i++) {
-        if (form[i] && form[i]->Is(RE::FormType::Armor, RE::FormType::Light)) continue;
-
-        DataWeapon data(type[i], name[i], enchNum[i], enchName[i], tempVal[i], form[i]);
-        weapon_right.push_back(data);
-    }
-}
-
-void DataHandler::InitShout() {
-    auto player = RE::PlayerCharacter::GetSingleton();
-    if (!player || !player->IsInitialized()) return;
-
-    auto config = ConfigHandler::GetSingleton();
-    if (!config) return;
-
-    auto ts = Translator::GetSingleton();
-    if (!ts) return;
-
-    bool favorOnly = config->Settings.favorOnly;
-    std::vector<Data::DATATYPE> type;
-    std::vector<std::string> name;
-    std::vector<RE::TESForm*> form;
-
-    type.push_back(Data::DATATYPE::NOTHING);
-    name.push_back(TRANSLATE("_NOTHING"));
-    form.push_back(nullptr);
-
-    auto basePowerSize = Actor::GetBaseSpellCount(player);
-    for (int i = 0; i < basePowerSize; i++) {
-        auto power = Actor::GetBaseNthSpell(player, i);
-        if (!power) continue;
-
-        auto powerType = power->GetSpellType();
-        if (powerType == RE::MagicSystem::SpellType::kPower ||
-            powerType == RE::MagicSystem::SpellType::kLesserPower) {
-            if (favorOnly && !Extra::IsMagicFavorited(power)) continue;
-
-            type.push_back(Data::DATATYPE::SHOUT);
-            name.push_back(power->GetName());
-            form.push_back(power->As<RE::TESForm>());
-        }
-    }
-
-    auto racePowerSize = Actor::GetRaceSpellCount(player);
-    for (int i = 0; i < racePowerSize; i++) {
-        auto power = Actor::GetRaceNthSpell(player, i);
-        if (!power) continue;
-
-        auto powerType = power->GetSpellType();
-        if (powerType == RE::MagicSystem::SpellType::kPower ||
-            powerType == RE::MagicSystem::SpellType::kLesserPower) {
-            if (favorOnly && !Extra::IsMagicFavorited(power)) continue;
-
-            type.push_back(Data::DATATYPE::SHOUT);
-            name.push_back(power->GetName());
-            form.push_back(power->As<RE::TESForm>());
-        }
-    }
-
-    auto powerSize = Actor::GetActorSpellCount(player);
-    for (int i = 0; i < powerSize; i++) {
-        auto power = Actor::GetActorNthSpell(player, i);
-        if (!power) continue;
-
-        auto powerType = power->GetSpellType();
-        if (powerType == RE::MagicSystem::SpellType::kPower ||
-            powerType == RE::MagicSystem::SpellType::kLesserPower) {
-            if (favorOnly && !Extra::IsMagicFavorited(power)) continue;
-
-            type.push_back(Data::DATATYPE::SHOUT);
-            name.push_back(power->GetName());
-            form.push_back(power->As<RE::TESForm>());
+            _source.spell.push_back(spell);
+        } else if (spellType == RE::MagicSystem::SpellType::kPower ||
+                   spellType == RE::MagicSystem::SpellType::kLesserPower) {
+            _source.shout.push_back(spell);
         }
     }
 
@@ -414,9 +204,7 @@ void DataHandler::InitShout() {
 
         if (favorOnly && !Extra::IsMagicFavorited(shout)) continue;
 
-        type.push_back(Data::DATATYPE::SHOUT);
-        name.push_back(shout->GetName());
-        form.push_back(shout->As<RE::TESForm>());
+        _source.shout.push_back(shout);
     }
 
     auto raceShoutSize = Actor::GetRaceShoutCount(player);
@@ -426,290 +214,103 @@ void DataHandler::InitShout() {
 
         if (favorOnly && !Extra::IsMagicFavorited(shout)) continue;
 
-        type.push_back(Data::DATATYPE::SHOUT);
-        name.push_back(shout->GetName());
-        form.push_back(shout->As<RE::TESForm>());
-    }
-
-    for (int i = 0; i < type.size(); i++) {
-        DataShout data(type[i], name[i], form[i]);
-        shout.push_back(data);
+        _source.shout.push_back(shout);
     }
 }
 
-void DataHandler::InitArmor() {
-    auto player = RE::PlayerCharacter::GetSingleton();
-    if (!player || !player->IsInitialized()) return;
-
-    auto playerBase = player->GetActorBase();
-    if (!playerBase) return;
-
-    auto config = ConfigHandler::GetSingleton();
-    if (!config) return;
-
-    auto ts = Translator::GetSingleton();
-    if (!ts) return;
-
-    bool favorOnly = config->Settings.favorOnly;
-    std::vector<Data::DATATYPE> type;
-    std::vector<std::string> name;
-    std::vector<uint32_t> enchNum;
-    std::vector<std::string> enchName;
-    std::vector<float> tempVal;
-    std::vector<RE::TESForm*> form;
+std::shared_ptr<ItemLists> DataHandler::Build(Source& _source) {
+    // Sorted by name, so the lists no longer follow the inventory map's hash order.
+    auto ItemName = [](const Source::Item& _item) { return std::string_view(_item.object->GetName()); };
+    auto FormName = [](const RE::TESForm* _form) { return std::string_view(_form->GetName()); };
+    std::ranges::stable_sort(_source.weapon, {}, ItemName);
+    std::ranges::stable_sort(_source.armor, {}, ItemName);
+    std::ranges::stable_sort(_source.potion, {}, ItemName);
+    std::ranges::stable_sort(_source.spell, {}, FormName);
+    std::ranges::stable_sort(_source.shout, {}, FormName);
+
+    auto result = std::make_shared<ItemLists>();
+    BuildWeapon(*result, _source);
+    BuildShout(*result, _source);
+    BuildArmor(*result, _source);
+    BuildPotion(*result, _source);
 
-    auto inv = player->GetInventory();
-    for (const auto& [item, data] : inv) {
-        const auto& [numItem, entry] = data;
-        if (numItem > 0 && item->Is(RE::FormType::Armor)) {
-            auto armor = item->As<RE::TESObjectARMO>();
-            if (armor && armor->IsShield()) continue;
-
-            uint32_t numExtra = 0;
-
-            auto extraLists = entry->extraLists;
-            if (extraLists) {
-                for (auto& _xList : *extraLists) {
-                    ++numExtra;
-                    if (favorOnly && !Extra::IsFavorited(_xList)) continue;
-
-                    type.push_back(Data::DATATYPE::ARMOR);
-                    name.push_back(item->GetName());
-                    enchNum.push_back(Extra::GetEnchNum(item, _xList));
-                    enchName.push_back(Extra::GetEnchName(item, _xList));
-                    tempVal.push_back(Extra::GetTempValue(_xList));
-                    form.push_back(item->As<RE::TESForm>());
-                }
-            }
-
-            if (favorOnly) continue;
-
-            for (uint32_t i = numExtra; i < numItem; i++) {
-                type.push_back(Data::DATATYPE::ARMOR);
-                name.push_back(item->GetName());
-                enchNum.push_back(Extra::GetEnchNum(item, nullptr));
-                enchName.push_back(Extra::GetEnchName(item, nullptr));
-                tempVal.push_back(0.0f);
-                form.push_back(item->As<RE::TESForm>());
-            }
-        }
-    }
-
-    for (int i = 0; i < type.size(); i++) {
-        DataArmor data(type[i], name[i], enchNum[i], enchName[i], tempVal[i], form[i]);
-        armor.push_back(data);
-    }
+    return result;
 }
 
-void DataHandler::InitPotion() {
-    auto player = RE::PlayerCharacter::GetSingleton();
-    if (!player || !player->IsInitialized()) return;
-
-    auto config = ConfigHandler::GetSingleton();
-    if (!config) return;
-
-    auto ts = Translator::GetSingleton();
-    if (!ts) return;
-
-    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
-    if (!TESDataHandler) return;
-
-    bool favorOnly = config->Settings.favorOnly;
-    
-    std::vector<Data::DATATYPE> type;
-    std::vector<Data::DATATYPE> type_health;
-    std::vector<Data::DATATYPE> type_magicka;
-    std::vector<Data::DATATYPE> type_stamina;
-    std::vector<std::string> name;
-    std::vector<std::string> name_health;
-    std::vector<std::string> name_magicka;
-    std::vector<std::string> name_stamina;
-    std::vector<RE::TESForm*> form;
-    std::vector<RE::TESForm*> form_health;
-    std::vector<RE::TESForm*> form_magicka;
-    std::vector<RE::TESForm*> form_stamina;
-
-    for (int i = 0; i < 3; i++) {
-        Data::DATATYPE _type;
-        std::string _name;
-        if (i == 0) {
-            _type = Data::DATATYPE::NOTHING;
-            _name = TRANSLATE("_NOTHING");
-        } else if (i == 1) {
-            _type = Data::DATATYPE::POTION_AUTO_HIGHEST;
-            _name = TRANSLATE("_AUTO_HIGHEST");
-        } else if (i == 2) {
-            _type = Data::DATATYPE::POTION_AUTO_LOWEST;
-            _name = TRANSLATE("_AUTO_LOWEST");
-        }
-        type_health.push_back(_type);
-        type_magicka.push_back(_type);
-        type_stamina.push_back(_type);
-        name_health.push_back(_name);
-        name_magicka.push_back(_name);
-        name_stamina.push_back(_name);
-        form_health.push_back(nullptr);
-        form_magicka.push_back(nullptr);
-        form_stamina.push_back(nullptr);
-    }
-
-    auto inv = player->GetInventory();
-    for (const auto& [item, data] : inv) {
-        const auto& [numItem, entry] = data;
-        if (numItem > 0 && item->Is(RE::FormType::AlchemyItem)) {
-            auto potion = item->As<RE::AlchemyItem>();
-            if (!potion) continue;
-
-            uint32_t foundType = 0;
-            for (auto effect : potion->effects) {
-                auto baseEffect = effect->baseEffect;
-                if (!baseEffect) break;
-
-                auto formid = baseEffect->GetFormID();
-                for (const auto& elem : config->healthVec) {
-                    auto compare = TESDataHandler->LookupFormID(elem.formid, elem.modname);
-                    if (formid == compare) {
-                        foundType = 1;
-                        break;
-                    }
-                }
-                for (const auto& elem : config->magickaVec) {
-                    auto compare = TESDataHandler->LookupFormID(elem.formid, elem.modname);
-                    if (formid == compare) {
-                        foundType = 2;
-                        break;
-                    }
-                }
-                for (const auto& elem : config->staminaVec) {
-                    auto compare = TESDataHandler->LookupFormID(elem.formid, elem.modname);
-                    if (formid == compare) {
-                        foundType = 3;
-                        break;
-                    }
-                }
-            }
-
-            auto extraLists = entry->extraLists;
-            if (extraLists) {
-                for (auto& _xList : *extraLists) {
-                    if (favorOnly && !Extra::IsFavorited(_xList)) continue;
-
-                    switch (foundType) {
-                        case 1:
-                            type_health.push_back(Data::DATATYPE::POTION);
-                            name_health.push_back(item->GetName());
-                            form_health.push_back(item->As<RE::TESForm>());
-                            break;
-                        case 2:
-                            type_magicka.push_back(Data::DATATYPE::POTION);
-                            name_magicka.push_back(item->GetName());
-                            form_magicka.push_back(item->As<RE::TESForm>());
-                            break;
-                        case 3:
-                            type_stamina.push_back(Data::DATATYPE::POTION);
-                            name_stamina.push_back(item->GetName());
-                            form_stamina.push_back(item->As<RE::TESForm>());
-                            break;
-                        default:
-                            type.push_back(Data::DATATYPE::POTION);
-                            name.push_back(item->GetName());
-                            form.push_back(item->As<RE::TESForm>());
-                            break;
-                    }
-                }
-            }
-
-            if (favorOnly) continue;
-
-            switch (foundType) {
-                case 1:
-                    type_health.push_back(Data::DATATYPE::POTION);
-                    name_health.push_back(item->GetName());
-                    form_health.push_back(item->As<RE::TESForm>());
-                    break;
-                case 2:
-                    type_magicka.push_back(Data::DATATYPE::POTION);
-                    name_magicka.push_back(item->GetName());
-                    form_magicka.push_back(item->As<RE::TESForm>());
-                    break;
-                case 3:
-                    type_stamina.push_back(Data::DATATYPE::POTION);
-                    name_stamina.push_back(item->GetName());
-                    form_stamina.push_back(item->As<RE::TESForm>());
-                    break;
-                default:
-                    type.push_back(Data::DATATYPE::POTION);
-                    name.push_back(item->GetName());
-                    form.push_back(item->As<RE::TESForm>());
-                    break;
-            }
-        }
+void DataHandler::BuildWeapon(ItemLists& _lists, Source& _source) {
+    // Every row goes to the left hand; the right hand skips shields and torches.
+    auto AddWeapon = [&_lists](Data::DATATYPE _type, std::string_view _name, RE::TESForm* _form, uint32_t _enchNum,
+                               std::string_view _enchName, float _tempVal) {
+        auto row = _lists.catalog.Add(_type, _name, _form, _enchNum, _enchName, _tempVal);
+        _lists.weapon_left.push_back(row);
+        if (!_form || !_form->Is(RE::FormType::Armor, RE::FormType::Light)) _lists.weapon_right.push_back(row);
+    };
+
+    AddWeapon(Data::DATATYPE::NOTHING, _source.nothing, nullptr, 0, Extra::ENCHNONE, 0.0f);
+    AddWeapon(Data::DATATYPE::UNEQUIP, _source.unequip, nullptr, 0, Extra::ENCHNONE, 0.0f);
+
+    for (const auto& item : _source.weapon) {
+        auto [enchNum, enchName] = GetEnchColumns(item.object, item.enchantment);
+        AddWeapon(Data::DATATYPE::WEAP, item.object->GetName(), item.object, enchNum, enchName, item.tempVal);
     }
 
-    for (int i = 0; i < type.size(); i++) {
-        DataPotion data(type[i], name[i], form[i]);
-        potion.push_back(data);
-    }
-    for (int i = 0; i < type_health.size(); i++) {
-        DataPotion data(type_health[i], name_health[i], form_health[i]);
-        potion_health.push_back(data);
-    }
-    for (int i = 0; i < type_magicka.size(); i++) {
-        DataPotion data(type_magicka[i], name_magicka[i], form_magicka[i]);
-        potion_magicka.push_back(data);
-    }
-    for (int i = 0; i < type_stamina.size(); i++) {
-        DataPotion data(type_stamina[i], name_stamina[i], form_stamina[i]);
-        potion_stamina.push_back(data);
+    for (auto spell : _source.spell) {
+        AddWeapon(Data::DATATYPE::SPELL, spell->GetName(), spell, 0, Extra::ENCHNONE, 0.0f);
     }
 }
 
-std::string WidgetIcon::Pack() {
-    std::string result;
-
-    result += std::to_string(enable) + Utility::delimiter;
-    result += type + Utility::delimiter;
-    result += std::to_string(offsetX) + Utility::delimiter;
-    result += std::to_string(offsetY) + Utility::delimiter;
+void DataHandler::BuildShout(ItemLists& _lists, Source& _source) {
+    _lists.shout.push_back(_lists.catalog.Add(Data::DATATYPE::NOTHING, _source.nothing, nullptr));
 
-    return result;
+    for (auto shout : _source.shout) {
+        _lists.shout.push_back(_lists.catalog.Add(Data::DATATYPE::SHOUT, shout->GetName(), shout));
+    }
 }
 
-WidgetIcon WidgetIcon::Unpack(const std::string& _packed) {
-    std::vector<std::string> dataVec = Utility::Split(_packed, Utility::delimiter);
-
-    assert(dataVec.size() == 4);
-
-    WidgetIcon result;
-    result.enable = Utility::to_bool(dataVec[0]);
-    result.type = dataVec[1];
-    result.offsetX = std::stoi(dataVec[2]);
-    result.offsetY = std::stoi(dataVec[3]);
-
-    return result;
+void DataHandler::BuildArmor(ItemLists& _lists, Source& _source) {
+    for (const auto& item : _source.armor) {
+        auto [enchNum, enchName] = GetEnchColumns(item.object, item.enchantment);
+        auto row = _lists.catalog.Add(Data::DATATYPE::ARMOR, item.object->GetName(), item.object, enchNum, enchName,
+                                      item.tempVal);
+        _lists.armor.insert(_lists.armor.end(), item.count, row);
+    }
 }
 
-std::string WidgetText::Pack() {
-    std::string result;
+void DataHandler::BuildPotion(ItemLists& _lists, Source& _source) {
+    // The header rows are shared by all three restore lists.
+    for (auto [type, name] : {std::make_pair(Data::DATATYPE::NOTHING, &_source.nothing),
+                              std::make_pair(Data::DATATYPE::POTION_AUTO_HIGHEST, &_source.autoHighest),
+                              std::make_pair(Data::DATATYPE::POTION_AUTO_LOWEST, &_source.autoLowest)}) {
+        auto row = _lists.catalog.Add(type, *name, nullptr);
+        _lists.potion_health.push_back(row);
+        _lists.potion_magicka.push_back(row);
+        _lists.potion_stamina.push_back(row);
+    }
 
-    result += std::to_string(enable) + Utility::delimiter;
-    result += std::to_string(static_cast<uint32_t>(align)) + Utility::delimiter;
-    result += std::to_string(offsetX) + Utility::delimiter;
-    result += std::to_string(offsetY) + Utility::delimiter;
+    for (const auto& item : _source.potion) {
+        auto potion = item.object->As<RE::AlchemyItem>();
+        if (!potion) continue;
 
-    return result;
-}
+        uint32_t foundType = 0;
+        for (auto effect : potion->effects) {
+            auto baseEffect = effect->baseEffect;
+            if (!baseEffect) break;
 
-WidgetText WidgetText::Unpack(const std::string& _packed) {
-    std::vector<std::string> dataVec = Utility::Split(_packed, Utility::delimiter);
+            auto it = _source.potionEffect.find(baseEffect->GetFormID());
+            if (it == _source.potionEffect.end()) continue;
 
-    assert(dataVec.size() == 4);
+            if (it->second & Config::POTION_HEALTH) foundType = 1;
+            if (it->second & Config::POTION_MAGICKA) foundType = 2;
+            if (it->second & Config::POTION_STAMINA) foundType = 3;
+        }
 
-    WidgetText result;
-    result.enable = Utility::to_bool(dataVec[0]);
-    result.align = static_cast<WidgetText::ALIGN_TYPE>(std::stoi(dataVec[1]));
-    result.offsetX = std::stoi(dataVec[2]);
-    result.offsetY = std::stoi(dataVec[3]);
+        auto& list = foundType == 1 ? _lists.potion_health
+                   : foundType == 2 ? _lists.potion_magicka
+                   : foundType == 3 ? _lists.potion_stamina
+                                    : _lists.potion;
 
-    return result;
+        // Every entry of one potion is identical, so they all share one row.
+        auto row = _lists.catalog.Add(Data::DATATYPE::POTION, item.object->GetName(), item.object);
+        list.insert(list.end(), item.count, row);
+    }
 }
\ No newline at end of file
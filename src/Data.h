@@ -1,5 +1,7 @@
 #pragma once
 
+class FormResolver;
+
 class Data {
 public:
     enum class DATATYPE { 
@@ -36,16 +38,13 @@ public:
                const float& _tempVal, RE::TESForm* _form)
         : Data(_type, _name), enchNum(_enchNum), enchName(_enchName), tempVal(_tempVal), form(_form) {}
     virtual std::string Pack() override;
-    static DataWeapon Unpack(const std::string& _packed);
-
-    void operator=(const DataWeapon& _object) {
-        this->type = _object.type;
-        this->name = _object.name;
-        this->enchNum = _object.enchNum;
-        this->enchName = _object.enchName;
-        this->tempVal = _object.tempVal;
-        this->form = _object.form;
-    }
+    static DataWeapon Unpack(std::string_view _packed);
+    static void Unpack(std::string_view _packed, DataWeapon& _out, FormResolver* _resolver);
+
+    DataWeapon(const DataWeapon&) = default;
+    DataWeapon(DataWeapon&&) = default;
+    DataWeapon& operator=(const DataWeapon&) = default;
+    DataWeapon& operator=(DataWeapon&&) = default;
 
     bool operator==(const DataWeapon& _object) const {
         return this->type == _object.type &&
@@ -69,13 +68,13 @@ public:
     DataShout();
     DataShout(DATATYPE _type, const std::string& _name, RE::TESForm* _form) : Data(_type, _name), form(_form) {}
     virtual std::string Pack() override;
-    static DataShout Unpack(const std::string& _packed);
+    static DataShout Unpack(std::string_view _packed);
+    static void Unpack(std::string_view _packed, DataShout& _out, FormResolver* _resolver);
 
-    void operator=(const DataShout& _object) {
-        this->type = _object.type;
-        this->name = _object.name;
-        this->form = _object.form;
-    }
+    DataShout(const DataShout&) = default;
+    DataShout(DataShout&&) = default;
+    DataShout& operator=(const DataShout&) = default;
+    DataShout& operator=(DataShout&&) = default;
 
     bool operator==(const DataShout& _object) const {
         return this->type == _object.type &&
@@ -101,16 +100,13 @@ public:
               const float& _tempVal, RE::TESForm* _form)
         : Data(_type, _name), enchNum(_enchNum), enchName(_enchName), tempVal(_tempVal), form(_form) {}
     virtual std::string Pack() override;
-    static DataArmor Unpack(const std::string& _packed);
-
-    void operator=(const DataArmor& _object) {
-        this->type = _object.type;
-        this->name = _object.name;
-        this->enchNum = _object.enchNum;
-        this->enchName = _object.enchName;
-        this->tempVal = _object.tempVal;
-        this->form = _object.form;
-    }
+    static DataArmor Unpack(std::string_view _packed);
+    static void Unpack(std::string_view _packed, DataArmor& _out, FormResolver* _resolver);
+
+    DataArmor(const DataArmor&) = default;
+    DataArmor(DataArmor&&) = default;
+    DataArmor& operator=(const DataArmor&) = default;
+    DataArmor& operator=(DataArmor&&) = default;
 
     bool operator==(const DataArmor& _object) const {
         return this->type == _object.type &&
@@ -134,13 +130,13 @@ public:
     DataPotion();
     DataPotion(DATATYPE _type, const std::string& _name, RE::TESForm* _form) : Data(_type, _name), form(_form) {}
     virtual std::string Pack() override;
-    static DataPotion Unpack(const std::string& _packed);
+    static DataPotion Unpack(std::string_view _packed);
+    static void Unpack(std::string_view _packed, DataPotion& _out, FormResolver* _resolver);
 
-    void operator=(const DataPotion& _object) {
-        this->type = _object.type;
-        this->name = _object.name;
-        this->form = _object.form;
-    }
+    DataPotion(const DataPotion&) = default;
+    DataPotion(DataPotion&&) = default;
+    DataPotion& operator=(const DataPotion&) = default;
+    DataPotion& operator=(DataPotion&&) = default;
 
     bool operator==(const DataPotion& _object) const {
         return this->type == _object.type &&
@@ -153,23 +149,109 @@ public:
     }
 };
 
+// Everything DataHandler collects, one column per field. Names and enchantment names are interned,
+// so a stack of identical items costs a few integers per row instead of two strings.
+class ItemCatalog {
+public:
+    using Row = uint32_t;
+
+    std::vector<Data::DATATYPE> type;
+    std::vector<uint32_t> name;  // Pool index
+    std::vector<uint32_t> enchNum;
+    std::vector<uint32_t> enchName;  // Pool index
+    std::vector<float> tempVal;
+    std::vector<RE::TESForm*> form;
+
+    ItemCatalog() = default;
+    // poolMap views point into pool, so a copy would point into its source; a move keeps the strings in place.
+    ItemCatalog(const ItemCatalog&) = delete;
+    ItemCatalog(ItemCatalog&&) = default;
+    ItemCatalog& operator=(const ItemCatalog&) = delete;
+    ItemCatalog& operator=(ItemCatalog&&) = default;
+
+    Row Add(Data::DATATYPE _type, std::string_view _name, RE::TESForm* _form, uint32_t _enchNum = 0U,
+            std::string_view _enchName = {}, float _tempVal = 0.0f);
+    size_t Size() const { return type.size(); }
+    const std::string& GetName(Row _row) const { return pool[name[_row]]; }
+    const std::string& GetEnchName(Row _row) const { return pool[enchName[_row]]; }
+
+    DataWeapon GetWeapon(Row _row) const;
+    DataShout GetShout(Row _row) const;
+    DataArmor GetArmor(Row _row) const;
+    DataPotion GetPotion(Row _row) const;
+
+private:
+    // Each build fills a fresh catalog, so the pool lives and dies with its lists.
+    std::deque<std::string> pool;
+    std::unordered_map<std::string_view, uint32_t> poolMap;
+
+    uint32_t Intern(std::string_view _value);
+};
+
+// One complete set of lists for the configuration GUI. Built whole on a worker and published at once,
+// so a reader holding it never sees a half-built list.
+class ItemLists {
+public:
+    ItemCatalog catalog;
+
+    // Rows of catalog
+    std::vector<ItemCatalog::Row> weapon_left;
+    std::vector<ItemCatalog::Row> weapon_right;
+    std::vector<ItemCatalog::Row> shout;
+    std::vector<ItemCatalog::Row> armor;
+    std::vector<ItemCatalog::Row> potion;
+    std::vector<ItemCatalog::Row> potion_health;
+    std::vector<ItemCatalog::Row> potion_magicka;
+    std::vector<ItemCatalog::Row> potion_stamina;
+};
+
 class DataHandler {
 public:
+    // Starts a rebuild and returns at once; Get() keeps returning the previous lists until it is published.
     void Init();
-    void InitWeapon();
-    void InitShout();
-    void InitArmor();
-    void InitPotion();
+    // Drops the lists and any rebuild still in flight.
     void Clear();
+    std::shared_ptr<const ItemLists> Get() const { return lists.load(); }
+    bool IsLoading() const { return published.load() < requested.load(); }
+
+private:
+    // Everything a rebuild reads from the game. Pointers are collected on the game thread,
+    // so the worker never walks the live inventory or spell lists.
+    struct Source {
+        struct Item {
+            RE::TESBoundObject* object{nullptr};
+            RE::EnchantmentItem* enchantment{nullptr};  // From the extra list, nullptr for the base enchantment
+            float tempVal{0.0f};
+            uint32_t count{1U};  // Identical copies, listed under one row
+        };
+
+        bool favorOnly{false};
+        std::string nothing;
+        std::string unequip;
+        std::string autoHighest;
+        std::string autoLowest;
+        std::unordered_map<RE::FormID, uint8_t> potionEffect;  // ConfigHandler::potionEffectMap
+
+        std::vector<Item> weapon;
+        std::vector<Item> armor;
+        std::vector<Item> potion;
+        std::vector<RE::SpellItem*> spell;
+        std::vector<RE::TESForm*> shout;  // Powers and shouts
+    };
+
+    void GatherItem(Source& _source);
+    void GatherMagic(Source& _source);
+    static std::shared_ptr<ItemLists> Build(Source& _source);
+    static void BuildWeapon(ItemLists& _lists, Source& _source);
+    static void BuildShout(ItemLists& _lists, Source& _source);
+    static void BuildArmor(ItemLists& _lists, Source& _source);
+    static void BuildPotion(ItemLists& _lists, Source& _source);
+    void Publish(std::shared_ptr<const ItemLists> _lists, uint32_t _generation);
 
-    std::vector<DataWeapon> weapon_left;
-    std::vector<DataWeapon> weapon_right;
-    std::vector<DataShout> shout;
-    std::vector<DataArmor> armor;
-    std::vector<DataPotion> potion;
-    std::vector<DataPotion> potion_health;
-    std::vector<DataPotion> potion_magicka;
-    std::vector<DataPotion> potion_stamina;
+    std::atomic<std::shared_ptr<const ItemLists>> lists{std::make_shared<const ItemLists>()};
+    std::atomic<uint32_t> requested{0U};
+    std::atomic<uint32_t> published{0U};
+    std::mutex publishLock;
 
 public:
     static DataHandler* GetSingleton() {
@@ -197,12 +279,12 @@ public:
 
 public:
     std::string Pack();
-    static WidgetIcon Unpack(const std::string& _packed);
+    static WidgetIcon Unpack(std::string_view _packed);
 };
 
 class WidgetText {
 public:
-    enum ALIGN_TYPE { LEFT, RIGHT, CENTER };
+    enum ALIGN_TYPE : uint32_t { LEFT, RIGHT, CENTER };
 
     bool enable{false};
     ALIGN_TYPE align{ALIGN_TYPE::CENTER};
@@ -211,7 +293,7 @@ public:
 
 public:
     std::string Pack();
-    static WidgetText Unpack(const std::string& _packed);
+    static WidgetText Unpack(std::string_view _packed);
 };
 
 class WidgetID {
@@ -0,0 +1,141 @@
+#include "Data.h"
+#include "ExtraData.h"
+#include "Translate.h"
+#include "Codec.h"
+
+using WeaponSchema = Codec::Schema<DataWeapon, Codec::Value<&DataWeapon::type>, Codec::Value<&DataWeapon::name>,
+                                   Codec::Value<&DataWeapon::enchNum>, Codec::Value<&DataWeapon::enchName>,
+                                   Codec::Value<&DataWeapon::tempVal>, Codec::Form<&DataWeapon::form>>;
+using ShoutSchema = Codec::Schema<DataShout, Codec::Value<&DataShout::type>, Codec::Value<&DataShout::name>,
+                                  Codec::Form<&DataShout::form>>;
+using ArmorSchema = Codec::Schema<DataArmor, Codec::Value<&DataArmor::type>, Codec::Value<&DataArmor::name>,
+                                  Codec::Value<&DataArmor::enchNum>, Codec::Value<&DataArmor::enchName>,
+                                  Codec::Value<&DataArmor::tempVal>, Codec::Form<&DataArmor::form>>;
+using PotionSchema = Codec::Schema<DataPotion, Codec::Value<&DataPotion::type>, Codec::Value<&DataPotion::name>,
+                                   Codec::Form<&DataPotion::form, true>>;
+using WidgetIconSchema = Codec::Schema<WidgetIcon, Codec::Value<&WidgetIcon::enable>, Codec::Value<&WidgetIcon::type>,
+                                       Codec::Value<&WidgetIcon::offsetX>, Codec::Value<&WidgetIcon::offsetY>>;
+using WidgetTextSchema = Codec::Schema<WidgetText, Codec::Value<&WidgetText::enable>, Codec::Value<&WidgetText::align>,
+                                       Codec::Value<&WidgetText::offsetX>, Codec::Value<&WidgetText::offsetY>>;
+
+DataWeapon::DataWeapon() {
+    auto ts = Translator::GetSingleton();
+    if (!ts) logger::error("Failed to get Translator.");
+
+    type = DATATYPE::NOTHING;
+    name = TRANSLATE("_NOTHING");
+    enchNum = 0;
+    enchName = Extra::ENCHNONE;
+    tempVal = 0.0f;
+    form = nullptr;
+}
+
+std::string DataWeapon::Pack() {
+    return WeaponSchema::Pack(*this);
+}
+
+
+DataWeapon DataWeapon::Unpack(std::string_view _packed) {
+    DataWeapon result;
+    Unpack(_packed, result, nullptr);
+
+    return result;
+}
+
+void DataWeapon::Unpack(std::string_view _packed, DataWeapon& _out, FormResolver* _resolver) {
+    if (!WeaponSchema::Unpack(_packed, _out, _resolver)) logger::warn("Malformed weapon data: {}", _packed);
+}
+
+DataShout::DataShout() {
+    auto ts = Translator::GetSingleton();
+    if (!ts) logger::error("Failed to get Translator.");
+
+    type = DATATYPE::NOTHING;
+    name = TRANSLATE("_NOTHING");
+    form = nullptr;
+}
+
+std::string DataShout::Pack() {
+    return ShoutSchema::Pack(*this);
+}
+
+DataShout DataShout::Unpack(std::string_view _packed) {
+    DataShout result;
+    Unpack(_packed, result, nullptr);
+
+    return result;
+}
+
+void DataShout::Unpack(std::string_view _packed, DataShout& _out, FormResolver* _resolver) {
+    if (!ShoutSchema::Unpack(_packed, _out, _resolver)) logger::warn("Malformed shout data: {}", _packed);
+}
+
+DataArmor::DataArmor() {
+    type = DATATYPE::NOTHING;
+    name = "";
+    enchNum = 0;
+    enchName = Extra::ENCHNONE;
+    tempVal = 0.0f;
+    form = nullptr;
+}
+
+std::string DataArmor::Pack() {
+    return ArmorSchema::Pack(*this);
+}
+
+DataArmor DataArmor::Unpack(std::string_view _packed) {
+    DataArmor result;
+    Unpack(_packed, result, nullptr);
+
+    return result;
+}
+
+void DataArmor::Unpack(std::string_view _packed, DataArmor& _out, FormResolver* _resolver) {
+    if (!ArmorSchema::Unpack(_packed, _out, _resolver)) logger::warn("Malformed armor data: {}", _packed);
+}
+
+DataPotion::DataPotion() {
+    auto ts = Translator::GetSingleton();
+    if (!ts) logger::error("Failed to get Translator.");
+
+    type = DATATYPE::NOTHING;
+    name = TRANSLATE("_NOTHING");
+    form = nullptr;
+}
+
+std::string DataPotion::Pack() {
+    return PotionSchema::Pack(*this);
+}
+
+DataPotion DataPotion::Unpack(std::string_view _packed) {
+    DataPotion result;
+    Unpack(_packed, result, nullptr);
+
+    return result;
+}
+
+void DataPotion::Unpack(std::string_view _packed, DataPotion& _out, FormResolver* _resolver) {
+    if (!PotionSchema::Unpack(_packed, _out, _resolver)) logger::warn("Malformed potion data: {}", _packed);
+}
+
+std::string WidgetIcon::Pack() {
+    return WidgetIconSchema::Pack(*this);
+}
+
+WidgetIcon WidgetIcon::Unpack(std::string_view _packed) {
+    WidgetIcon result;
+    if (!WidgetIconSchema::Unpack(_packed, result)) logger::warn("Malformed widget icon data: {}", _packed);
+
+    return result;
+}
+
+std::string WidgetText::Pack() {
+    return WidgetTextSchema::Pack(*this);
+}
+
+WidgetText WidgetText::Unpack(std::string_view _packed) {
+    WidgetText result;
+    if (!WidgetTextSchema::Unpack(_packed, result)) logger::warn("Malformed widget text data: {}", _packed);
+
+    return result;
+}
\ No newline at end of file
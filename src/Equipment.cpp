@@ -4,6 +4,7 @@
 #include "Config.h"
 #include "Actor.h"
 #include "Translate.h"
+#include "FileWriter.h"
 
 #include <filesystem>
 #include <toml++/toml.h>
@@ -712,12 +713,6 @@ void EquipmentManager::Load() {
 }
 
 void EquipmentManager::Save() {
-    std::ofstream f(equipment_path);
-    if (!f.is_open()) {
-        logger::error("Failed to save equipment!");
-        return;
-    }
-
     toml::table mainTbl;
     
     for (int i = 0; i < 32; i++) {
@@ -765,6 +760,7 @@ void EquipmentManager::Save() {
         mainTbl.insert("Shout", tbl);
     }
 
-    f << mainTbl;
+    FileWriter::GetSingleton()->Write(equipment_path,
+                                      [tbl = std::move(mainTbl)](std::ostream& _stream) { _stream << tbl; });
     logger::info("Equipment saved.");
 }
\ No newline at end of file
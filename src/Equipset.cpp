@@ -7,6 +7,8 @@
 #include "WidgetHandler.h"
 #include "Config.h"
 #include "ExtraData.h"
+#include "Cosave.h"
+#include "InventorySnapshot.h"
 
 #include <future>
 
@@ -83,6 +85,8 @@ static void UnequipItem(RE::TESForm* _form, RE::BGSEquipSlot* _slot, bool _sound
 }
 
 void NormalSet::Equip() {
+    Materialize();
+
     auto player = RE::PlayerCharacter::GetSingleton();
     if (!player) return;
 
@@ -233,11 +237,21 @@ void NormalSet::Equip() {
     }
     */
 
+    // One filtered inventory pass serves every lookup below.
+    std::vector<RE::TESForm*> forms{equipset->lefthand.form, equipset->righthand.form};
+    for (const auto& armor : equipset->items) {
+        forms.push_back(armor.form);
+    }
+
+    Extra::ExtraDataIndex index;
+    index.Build(forms);
+
     for (int i = 0; i < equipset->items.size(); i++) {
         if (unequipItems[i] && equipset->items[i].form) {
             auto& armor = equipset->items[i];
-            auto xList = Extra::SearchExtraDataList(armor.name, armor.enchNum, armor.enchName, armor.tempVal);
+            auto xList = index.Search(armor.form, armor.enchNum, armor.enchName, armor.tempVal);
             UnequipItem(equipset->items[i].form, nullptr, equipset->equipSound, xList);
+            index.Invalidate();
         }
     }
 
@@ -245,15 +259,17 @@ void NormalSet::Equip() {
         equipset->lefthand.type != Data::DATATYPE::NOTHING &&
         equipset->lefthand.type != Data::DATATYPE::UNEQUIP) {
         auto& weapon = equipset->lefthand;
-        auto xList = Extra::SearchExtraDataList(weapon.name, weapon.enchNum, weapon.enchName, weapon.tempVal);
+        auto xList = index.Search(weapon.form, weapon.enchNum, weapon.enchName, weapon.tempVal);
         EquipItem(equipset->lefthand.form, GetLeftHandSlot(), equipset->equipSound, xList);
+        index.Invalidate();
     }
     if (equipRight && equipset->righthand.form &&
         equipset->righthand.type != Data::DATATYPE::NOTHING &&
         equipset->righthand.type != Data::DATATYPE::UNEQUIP) {
         auto& weapon = equipset->righthand;
-        auto xList = Extra::SearchExtraDataList(weapon.name, weapon.enchNum, weapon.enchName, weapon.tempVal);
+        auto xList = index.Search(weapon.form, weapon.enchNum, weapon.enchName, weapon.tempVal);
         EquipItem(equipset->righthand.form, GetRightHandSlot(), equipset->equipSound, xList);
+        index.Invalidate();
     }
     if (equipShout && equipset->shout.form &&
         equipset->shout.type != Data::DATATYPE::NOTHING &&
@@ -264,8 +280,9 @@ void NormalSet::Equip() {
     for (int i = 0; i < equipset->items.size(); i++) {
         if (equipItems[i] && equipset->items[i].form) {
             auto& armor = equipset->items[i];
-            auto xList = Extra::SearchExtraDataList(armor.name, armor.enchNum, armor.enchName, armor.tempVal);
+            auto xList = index.Search(armor.form, armor.enchNum, armor.enchName, armor.tempVal);
             EquipItem(equipset->items[i].form, nullptr, equipset->equipSound, xList);
+            index.Invalidate();
         }
     }
 
@@ -279,6 +296,8 @@ void NormalSet::Equip() {
 }
 
 void PotionSet::Equip() {
+    Materialize();
+
     auto player = RE::PlayerCharacter::GetSingleton();
     if (!player) return;
 
@@ -325,6 +344,8 @@ void PotionSet::Equip() {
 }
 
 void CycleSet::Equip() {
+    Materialize();
+
     bool test = false;
     if(this->cycleIndex == 1) {
         test = true;
@@ -771,6 +792,12 @@ void Equipset::CreateWidgetText2() {
 }
 
 void NormalSet::CreateWidget() {
+    auto manager = EquipsetManager::GetSingleton();
+    if (!manager || !manager->IsLayerActive(this->layer)) return;
+
+    if (!IsMaterialized() && !isWidgetVisible) return;
+    Materialize();
+
     this->CreateWidgetBackground();
     this->CreateWidgetIcon();
     this->CreateWidgetText1();
@@ -788,6 +815,12 @@ void NormalSet::RemoveWidget() {
 }
 
 void PotionSet::CreateWidget() {
+    auto manager = EquipsetManager::GetSingleton();
+    if (!manager || !manager->IsLayerActive(this->layer)) return;
+
+    if (!IsMaterialized() && !isWidgetVisible) return;
+    Materialize();
+
     this->CreateWidgetBackground();
     this->CreateWidgetIcon();
     this->CreateWidgetText1();
@@ -805,6 +838,12 @@ void PotionSet::RemoveWidget() {
 }
 
 void CycleSet::CreateWidget() {
+    auto manager = EquipsetManager::GetSingleton();
+    if (!manager || !manager->IsLayerActive(this->layer)) return;
+
+    if (!IsMaterialized() && !isWidgetVisible) return;
+    Materialize();
+
     this->CreateWidgetBackground();
     this->CreateWidgetIcon();
     this->CreateWidgetText1();
@@ -821,6 +860,19 @@ void CycleSet::RemoveWidget() {
     widgetHandler->UnloadText(this->widgetID.text2);
 }
 
+// Stamps are unique across all equipsets, so a recycled handle never matches a stale cosave cache entry.
+static std::atomic<uint32_t> revisionHolder{1U};
+
+void Equipset::MarkDirty() {
+    revision.store(revisionHolder.fetch_add(1U, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void Equipset::Materialize() {
+    if (IsMaterialized()) return;
+
+    Cosave::Materialize(this);
+}
+
 void Equipset::SyncEquipset(const std::string& _prevName, const std::string& _curName) {
     auto manager = EquipsetManager::GetSingleton();
     if (!manager) return;
@@ -829,9 +881,11 @@ void Equipset::SyncEquipset(const std::string& _prevName, const std::string& _cu
         if (elem->type != Equipset::TYPE::CYCLE) continue;
 
         auto cycleset = static_cast<CycleSet*>(elem);
+        cycleset->Materialize();
         for (auto& item : cycleset->items) {
             if (item == _prevName) {
                 item = _curName;
+                cycleset->MarkDirty();
                 break;
             }
         }
@@ -909,9 +963,6 @@ void PotionSet::AssignAutoPotion() {
     auto config = ConfigHandler::GetSingleton();
     if (!config) return;
 
-    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
-    if (!TESDataHandler) return;
-
     std::vector<RE::AlchemyItem*> health;
     std::vector<RE::AlchemyItem*> magicka;
     std::vector<RE::AlchemyItem*> stamina;
@@ -922,7 +973,10 @@ void PotionSet::AssignAutoPotion() {
     std::vector<uint32_t> magicka_duration;
     std::vector<uint32_t> stamina_duration;
 
-    auto inv = player->GetInventory();
+    auto snapshot = InventorySnapshot::GetSingleton();
+    if (!snapshot) return;
+
+    const auto& inv = snapshot->Get();
     for (const auto& [item, data] : inv) {
         const auto& [numItem, entry] = data;
         if (numItem > 0 && item->Is(RE::FormType::AlchemyItem)) {
@@ -933,33 +987,21 @@ void PotionSet::AssignAutoPotion() {
                 auto baseEffect = effect->baseEffect;
                 if (!baseEffect) break;
 
-                auto formid = baseEffect->GetFormID();
-                for (const auto& elem : config->healthVec) {
-                    auto compare = TESDataHandler->LookupFormID(elem.formid, elem.modname);
-                    if (formid == compare) {
-                        health.push_back(potion);
-                        health_magnitude.push_back(effect->GetMagnitude());
-                        health_duration.push_back(effect->GetDuration());
-                        break;
-                    }
+                auto flags = config->GetPotionFlags(baseEffect->GetFormID());
+                if (flags & Config::POTION_HEALTH) {
+                    health.push_back(potion);
+                    health_magnitude.push_back(effect->GetMagnitude());
+                    health_duration.push_back(effect->GetDuration());
                 }
-                for (const auto& elem : config->magickaVec) {
-                    auto compare = TESDataHandler->LookupFormID(elem.formid, elem.modname);
-                    if (formid == compare) {
-                        magicka.push_back(potion);
-                        magicka_magnitude.push_back(effect->GetMagnitude());
-                        magicka_duration.push_back(effect->GetDuration());
-                        break;
-                    }
+                if (flags & Config::POTION_MAGICKA) {
+                    magicka.push_back(potion);
+                    magicka_magnitude.push_back(effect->GetMagnitude());
+                    magicka_duration.push_back(effect->GetDuration());
                 }
-                for (const auto& elem : config->staminaVec) {
-                    auto compare = TESDataHandler->LookupFormID(elem.formid, elem.modname);
-                    if (formid == compare) {
-                        stamina.push_back(potion);
-                        stamina_magnitude.push_back(effect->GetMagnitude());
-                        stamina_duration.push_back(effect->GetDuration());
-                        break;
-                    }
+                if (flags & Config::POTION_STAMINA) {
+                    stamina.push_back(potion);
+                    stamina_magnitude.push_back(effect->GetMagnitude());
+                    stamina_duration.push_back(effect->GetDuration());
                 }
             }
         }
@@ -998,20 +1040,16 @@ static std::string GetAmount(RE::TESForm* _item) {
 
     if (!_item) return result;
 
-    auto player = RE::PlayerCharacter::GetSingleton();
-    if (!player) return result;
+    auto object = _item->As<RE::TESBoundObject>();
+    if (!object || !_item->Is(RE::FormType::AlchemyItem)) return result;
 
-    auto inv = player->GetInventory();
-    for (const auto& [item, data] : inv) {
-        const auto& [numItem, entry] = data;
-        if (numItem > 0 && item->Is(RE::FormType::AlchemyItem)) {
-            auto id = item->GetFormID();
-            auto compareid = _item->GetFormID();
+    auto snapshot = InventorySnapshot::GetSingleton();
+    if (!snapshot) return result;
 
-            if (id == compareid) {
-                return std::to_string(numItem);
-            }
-        }
+    const auto& inv = snapshot->Get();
+    auto it = inv.find(object);
+    if (it != inv.end() && it->second.first > 0) {
+        return std::to_string(it->second.first);
     }
 
     return result;
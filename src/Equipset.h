@@ -10,15 +10,31 @@ public:
         CYCLE
     };
 
+    enum class GESTURE : std::uint8_t {
+        PRESS,
+        HOLD,
+        DOUBLE_TAP
+    };
+
     TYPE type{TYPE::NORMAL};
 	std::string name{""};
     uint32_t hotkey{0U};
     bool modifier1{false};
     bool modifier2{false};
     bool modifier3{false};
+    GESTURE gesture{GESTURE::PRESS};
+    uint32_t leader{0U};
+    uint32_t layer{0U};
+    uint32_t padMask{0U};
     uint32_t order{0U};
+    uint32_t handle{0U};  // EquipsetHandle, assigned by the owning pool
+    uint32_t layerSlot{0U};  // Index in the manager's list of its layer's sets, assigned by the manager
+    std::atomic<uint32_t> revision{0U};  // Stamp of the last change the cosave has to pick up, 0 if never stamped
+    uint64_t payload{0U};  // Library hash of a payload not decoded yet, 0 once materialized
+    bool isWidgetVisible{false};  // Whether a pending payload enables any widget
 
     Equipset() {}
+    virtual ~Equipset() = default;
     virtual void Equip() = 0;
     virtual void CreateWidget() = 0;
     virtual void RemoveWidget() = 0;
@@ -26,6 +42,10 @@ public:
     void CreateWidgetIcon();
     void CreateWidgetText1();
     void CreateWidgetText2();
+    void MarkDirty();
+    bool IsMaterialized() const { return payload == 0U; }
+    void Materialize();
+    void DiscardPayload() { payload = 0U; }  // Keeps the current fields over a payload that failed to load
     void SyncEquipset(const std::string& _prevName, const std::string& _curName);
     void SyncWidget();
 };
@@ -56,6 +76,12 @@ public:
         this->modifier1 = _equipset.modifier1;
         this->modifier2 = _equipset.modifier2;
         this->modifier3 = _equipset.modifier3;
+        this->gesture = _equipset.gesture;
+        this->leader = _equipset.leader;
+        this->layer = _equipset.layer;
+        this->padMask = _equipset.padMask;
+        this->payload = _equipset.payload;
+        this->isWidgetVisible = _equipset.isWidgetVisible;
         this->equipSound = _equipset.equipSound;
         this->toggleEquip = _equipset.toggleEquip;
         this->reEquip = _equipset.reEquip;
@@ -67,6 +93,31 @@ public:
         this->shout = _equipset.shout;
         this->items = _equipset.items;
     }
+
+    void operator=(NormalSet&& _equipset) {
+        this->type = _equipset.type;
+        this->name = std::move(_equipset.name);
+        this->hotkey = _equipset.hotkey;
+        this->modifier1 = _equipset.modifier1;
+        this->modifier2 = _equipset.modifier2;
+        this->modifier3 = _equipset.modifier3;
+        this->gesture = _equipset.gesture;
+        this->leader = _equipset.leader;
+        this->layer = _equipset.layer;
+        this->padMask = _equipset.padMask;
+        this->payload = _equipset.payload;
+        this->isWidgetVisible = _equipset.isWidgetVisible;
+        this->equipSound = _equipset.equipSound;
+        this->toggleEquip = _equipset.toggleEquip;
+        this->reEquip = _equipset.reEquip;
+        this->widgetIcon = std::move(_equipset.widgetIcon);
+        this->widgetName = std::move(_equipset.widgetName);
+        this->widgetHotkey = std::move(_equipset.widgetHotkey);
+        this->lefthand = std::move(_equipset.lefthand);
+        this->righthand = std::move(_equipset.righthand);
+        this->shout = std::move(_equipset.shout);
+        this->items = std::move(_equipset.items);
+    }
 };
 
 class PotionSet : public Equipset {
@@ -98,6 +149,12 @@ public:
         this->modifier1 = _equipset.modifier1;
         this->modifier2 = _equipset.modifier2;
         this->modifier3 = _equipset.modifier3;
+        this->gesture = _equipset.gesture;
+        this->leader = _equipset.leader;
+        this->layer = _equipset.layer;
+        this->padMask = _equipset.padMask;
+        this->payload = _equipset.payload;
+        this->isWidgetVisible = _equipset.isWidgetVisible;
         this->equipSound = _equipset.equipSound;
         this->calcDuration = _equipset.calcDuration;
         this->widgetIcon = _equipset.widgetIcon;
@@ -108,6 +165,30 @@ public:
         this->stamina = _equipset.stamina;
         this->items = _equipset.items;
     }
+
+    void operator=(PotionSet&& _equipset) {
+        this->type = _equipset.type;
+        this->name = std::move(_equipset.name);
+        this->hotkey = _equipset.hotkey;
+        this->modifier1 = _equipset.modifier1;
+        this->modifier2 = _equipset.modifier2;
+        this->modifier3 = _equipset.modifier3;
+        this->gesture = _equipset.gesture;
+        this->leader = _equipset.leader;
+        this->layer = _equipset.layer;
+        this->padMask = _equipset.padMask;
+        this->payload = _equipset.payload;
+        this->isWidgetVisible = _equipset.isWidgetVisible;
+        this->equipSound = _equipset.equipSound;
+        this->calcDuration = _equipset.calcDuration;
+        this->widgetIcon = std::move(_equipset.widgetIcon);
+        this->widgetName = std::move(_equipset.widgetName);
+        this->widgetAmount = std::move(_equipset.widgetAmount);
+        this->health = std::move(_equipset.health);
+        this->magicka = std::move(_equipset.magicka);
+        this->stamina = std::move(_equipset.stamina);
+        this->items = std::move(_equipset.items);
+    }
 };
 
 class CycleSet : public Equipset {
@@ -154,6 +235,12 @@ public:
         this->modifier1 = _cycleset.modifier1;
         this->modifier2 = _cycleset.modifier2;
         this->modifier3 = _cycleset.modifier3;
+        this->gesture = _cycleset.gesture;
+        this->leader = _cycleset.leader;
+        this->layer = _cycleset.layer;
+        this->padMask = _cycleset.padMask;
+        this->payload = _cycleset.payload;
+        this->isWidgetVisible = _cycleset.isWidgetVisible;
         this->cyclePersist = _cycleset.cyclePersist;
         this->cycleExpire = _cycleset.cycleExpire;
         this->cycleReset = _cycleset.cycleReset;
@@ -161,5 +248,31 @@ public:
         this->widgetName = _cycleset.widgetName;
         this->widgetHotkey = _cycleset.widgetHotkey;
         this->items = _cycleset.items;
+        this->cycleIndex = _cycleset.cycleIndex;
+        this->isCycleInit = _cycleset.isCycleInit;
+    }
+
+    void operator=(CycleSet&& _cycleset) {
+        this->type = _cycleset.type;
+        this->name = std::move(_cycleset.name);
+        this->hotkey = _cycleset.hotkey;
+        this->modifier1 = _cycleset.modifier1;
+        this->modifier2 = _cycleset.modifier2;
+        this->modifier3 = _cycleset.modifier3;
+        this->gesture = _cycleset.gesture;
+        this->leader = _cycleset.leader;
+        this->layer = _cycleset.layer;
+        this->padMask = _cycleset.padMask;
+        this->payload = _cycleset.payload;
+        this->isWidgetVisible = _cycleset.isWidgetVisible;
+        this->cyclePersist = _cycleset.cyclePersist;
+        this->cycleExpire = _cycleset.cycleExpire;
+        this->cycleReset = _cycleset.cycleReset;
+        this->widgetIcon = std::move(_cycleset.widgetIcon);
+        this->widgetName = std::move(_cycleset.widgetName);
+        this->widgetHotkey = std::move(_cycleset.widgetHotkey);
+        this->items = std::move(_cycleset.items);
+        this->cycleIndex = _cycleset.cycleIndex;
+        this->isCycleInit = _cycleset.isCycleInit;
     }
 };
\ No newline at end of file
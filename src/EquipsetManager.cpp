@@ -4,10 +4,16 @@
 #include "Gui/GuiMenu.h"
 #include "WidgetHandler.h"
 #include "Serialize.h"
-
-void EquipsetManager::Create(const NormalSet& _equipset, bool _assignOrder) {
-	NormalSet* newSet = new NormalSet;
-	*newSet = _equipset;
+#include "HUDHandler.h"
+#include "Cosave.h"
+
+void EquipsetManager::Create(NormalSet&& _equipset, bool _assignOrder) {
+    auto handle = normalPool.Insert(std::move(_equipset));
+    auto newSet = normalPool.Get(handle);
+    if (!newSet) {
+        logger::error("Equipset pool is full.");
+        return;
+    }
 
     newSet->widgetID.background = AssignWidgetID();
     newSet->widgetID.icon = AssignWidgetID();
@@ -17,15 +23,23 @@ void EquipsetManager::Create(const NormalSet& _equipset, bool _assignOrder) {
 
 	Equipset* equipset = newSet;
 	equipsetVec.push_back(equipset);
+    AddName(equipset);
+    AddChord(equipset);
+    equipset->MarkDirty();
 
     newSet->CreateWidget();
 }
 
-void EquipsetManager::Create(const PotionSet& _equipset, bool _assignOrder) {
-    PotionSet* newSet = new PotionSet;
-    *newSet = _equipset;
+void EquipsetManager::Create(PotionSet&& _equipset, bool _assignOrder) {
+    auto handle = potionPool.Insert(std::move(_equipset));
+    auto newSet = potionPool.Get(handle);
+    if (!newSet) {
+        logger::error("Equipset pool is full.");
+        return;
+    }
 
-    newSet->AssignAutoPotion();
+    // A lazily loaded set picks its potions when its payload is decoded.
+    if (newSet->IsMaterialized()) newSet->AssignAutoPotion();
 
     newSet->widgetID.background = AssignWidgetID();
     newSet->widgetID.icon = AssignWidgetID();
@@ -35,13 +49,20 @@ void EquipsetManager::Create(const PotionSet& _equipset, bool _assignOrder) {
 
     Equipset* equipset = newSet;
     equipsetVec.push_back(equipset);
+    AddName(equipset);
+    AddChord(equipset);
+    equipset->MarkDirty();
 
     newSet->CreateWidget();
 }
 
-void EquipsetManager::Create(const CycleSet& _equipset, bool _assignOrder) {
-    CycleSet* newSet = new CycleSet;
-    *newSet = _equipset;
+void EquipsetManager::Create(CycleSet&& _equipset, bool _assignOrder) {
+    auto handle = cyclePool.Insert(std::move(_equipset));
+    auto newSet = cyclePool.Get(handle);
+    if (!newSet) {
+        logger::error("Equipset pool is full.");
+        return;
+    }
 
     newSet->widgetID.background = AssignWidgetID();
     newSet->widgetID.icon = AssignWidgetID();
@@ -51,50 +72,292 @@ void EquipsetManager::Create(const CycleSet& _equipset, bool _assignOrder) {
 
     Equipset* equipset = newSet;
     equipsetVec.push_back(equipset);
+    AddName(equipset);
+    AddChord(equipset);
+    equipset->MarkDirty();
 
     newSet->CreateWidget();
 }
 
+Equipset* EquipsetManager::Resolve(const uint32_t& _handle) {
+    switch (EquipsetHandle::GetType(_handle)) {
+        case Equipset::TYPE::NORMAL:
+            return normalPool.Get(_handle);
+        case Equipset::TYPE::POTION:
+            return potionPool.Get(_handle);
+        case Equipset::TYPE::CYCLE:
+            return cyclePool.Get(_handle);
+        default:
+            return nullptr;
+    }
+}
+
 void EquipsetManager::Remove(Equipset* _equipset) {
     if (!_equipset) return;
 
-    for (int i = 0; i < equipsetVec.size(); i++) {
-        if (_equipset->name == equipsetVec[i]->name) {
-            equipsetVec.erase(equipsetVec.begin() + i);
-            delete _equipset;
-        }
+    auto it = std::ranges::find(equipsetVec, _equipset);
+    if (it == equipsetVec.end()) return;
+
+    RemoveName(_equipset);
+    RemoveChord(_equipset);
+    equipsetVec.erase(it);
+
+    auto handle = _equipset->handle;
+    switch (EquipsetHandle::GetType(handle)) {
+        case Equipset::TYPE::NORMAL:
+            normalPool.Erase(handle);
+            break;
+        case Equipset::TYPE::POTION:
+            potionPool.Erase(handle);
+            break;
+        case Equipset::TYPE::CYCLE:
+            cyclePool.Erase(handle);
+            break;
+        default:
+            break;
     }
 }
 
 void EquipsetManager::RemoveAll() {
-    for (auto equipset : equipsetVec) {
-        delete equipset;
-    }
+    normalPool.Clear();
+    potionPool.Clear();
+    cyclePool.Clear();
 
     equipsetVec.clear();
+    nameMap.clear();
+    presetSuffixMap.clear();
+    for (auto& layer : layers) {
+        layer->Clear();
+    }
+    for (auto& sets : layerSets) {
+        sets.clear();
+    }
+    unboundMap.clear();
+    padButtonCounts.fill(0U);
+    padChordMask.store(0U);
+    holdKeyCounts.clear();
+    for (auto& bits : holdKeyMask) {
+        bits.store(0U);
+    }
+}
+
+ChordAutomaton* EquipsetManager::GetLayer(const uint32_t& _layer) {
+    while (layers.size() <= _layer) {
+        layers.push_back(std::make_unique<ChordAutomaton>());
+        layerSets.emplace_back();
+    }
+
+    return layers[_layer].get();
+}
+
+void EquipsetManager::AddToLayer(Equipset* _equipset) {
+    GetLayer(_equipset->layer);
+
+    auto& sets = layerSets[_equipset->layer];
+    _equipset->layerSlot = static_cast<uint32_t>(sets.size());
+    sets.push_back(_equipset);
+}
+
+void EquipsetManager::RemoveFromLayer(Equipset* _equipset) {
+    if (_equipset->layer >= layerSets.size()) return;
+
+    // The last set takes the freed slot.
+    auto& sets = layerSets[_equipset->layer];
+    auto slot = _equipset->layerSlot;
+    if (slot >= sets.size() || sets[slot] != _equipset) return;
+
+    sets[slot] = sets.back();
+    sets[slot]->layerSlot = slot;
+    sets.pop_back();
+}
+
+EquipsetManager::ChordId EquipsetManager::GetChordId(Equipset* _equipset) {
+    return {ChordAutomaton::GetToken(_equipset), ChordAutomaton::GetLeaderToken(_equipset), _equipset->layer,
+            _equipset->gesture};
+}
+
+bool EquipsetManager::AddChord(Equipset* _equipset) {
+    if (!_equipset) return false;
+
+    AddToLayer(_equipset);
+    AddPadButtons(_equipset->padMask);
+    AddHoldKey(_equipset);
+    if (_equipset->hotkey == 0 || GetLayer(_equipset->layer)->Add(_equipset)) return true;
+
+    // Imported files may bind one chord twice; the set stays unbound until the holder lets go of it.
+    auto holder = SearchEquipsetByChord(_equipset->hotkey, _equipset->modifier1, _equipset->modifier2,
+                                        _equipset->modifier3, _equipset->gesture, _equipset->leader,
+                                        _equipset->layer, _equipset->padMask);
+    logger::warn("Equipset '{}' shares its hotkey with '{}' and is left unbound.", _equipset->name,
+                 holder ? holder->name : "");
+    unboundMap[GetChordId(_equipset)].push_back(_equipset);
+    return false;
+}
+
+void EquipsetManager::RemoveChord(Equipset* _equipset) {
+    if (!_equipset) return;
+
+    auto layer = GetLayer(_equipset->layer);
+    auto isBound = layer->Remove(_equipset);
+    auto it = _equipset->hotkey != 0 ? unboundMap.find(GetChordId(_equipset)) : unboundMap.end();
+    if (it != unboundMap.end()) {
+        auto& waiting = it->second;
+        if (isBound) {
+            // Hand the freed chord to the next set that was left unbound on it.
+            layer->Add(waiting.front());
+            waiting.erase(waiting.begin());
+        } else {
+            std::erase(waiting, _equipset);
+        }
+        if (waiting.empty()) unboundMap.erase(it);
+    }
+
+    RemovePadButtons(_equipset->padMask);
+    RemoveHoldKey(_equipset);
+    RemoveFromLayer(_equipset);
+}
+
+void EquipsetManager::SetChord(Equipset* _equipset, const uint32_t& _hotkey, bool _modifier1, bool _modifier2,
+                               bool _modifier3, Equipset::GESTURE _gesture, const uint32_t& _leader,
+                               const uint32_t& _layer, const uint32_t& _padMask) {
+    if (!_equipset) return;
+
+    // An unchanged chord keeps its slot instead of passing it to a set left unbound on it.
+    if (_equipset->hotkey == _hotkey && _equipset->modifier1 == _modifier1 && _equipset->modifier2 == _modifier2 &&
+        _equipset->modifier3 == _modifier3 && _equipset->gesture == _gesture && _equipset->leader == _leader &&
+        _equipset->layer == _layer && _equipset->padMask == _padMask) {
+        return;
+    }
+
+    RemoveChord(_equipset);
+    _equipset->hotkey = _hotkey;
+    _equipset->modifier1 = _modifier1;
+    _equipset->modifier2 = _modifier2;
+    _equipset->modifier3 = _modifier3;
+    _equipset->gesture = _gesture;
+    _equipset->leader = _leader;
+    _equipset->layer = _layer;
+    _equipset->padMask = _padMask;
+    AddChord(_equipset);
+}
+
+void EquipsetManager::AddPadButtons(const uint32_t& _padMask) {
+    for (auto bits = _padMask; bits != 0U; bits &= bits - 1U) {
+        padButtonCounts[std::countr_zero(bits)]++;
+    }
+    padChordMask.fetch_or(_padMask);
+}
+
+void EquipsetManager::AddHoldKey(Equipset* _equipset) {
+    if (_equipset->hotkey == 0 || _equipset->gesture != Equipset::GESTURE::HOLD) return;
+
+    auto key = static_cast<uint64_t>(_equipset->layer) << 32 | _equipset->hotkey;
+    if (holdKeyCounts[key]++ == 0 && _equipset->layer == activeLayerIndex) SetHoldKeyBit(_equipset->hotkey, true);
 }
 
+void EquipsetManager::RemoveHoldKey(Equipset* _equipset) {
+    if (_equipset->hotkey == 0 || _equipset->gesture != Equipset::GESTURE::HOLD) return;
+
+    auto it = holdKeyCounts.find(static_cast<uint64_t>(_equipset->layer) << 32 | _equipset->hotkey);
+    if (it == holdKeyCounts.end() || --it->second != 0) return;
+
+    holdKeyCounts.erase(it);
+    if (_equipset->layer == activeLayerIndex) SetHoldKeyBit(_equipset->hotkey, false);
+}
+
+void EquipsetManager::SetHoldKeyBit(const uint32_t& _hotkey, bool _isSet) {
+    if (_hotkey >= holdKeyLimit) return;
+
+    auto bit = 1ULL << (_hotkey % 64U);
+    if (_isSet) {
+        holdKeyMask[_hotkey / 64U].fetch_or(bit);
+    } else {
+        holdKeyMask[_hotkey / 64U].fetch_and(~bit);
+    }
+}
+
+void EquipsetManager::RemovePadButtons(const uint32_t& _padMask) {
+    uint32_t released = 0U;
+    for (auto bits = _padMask; bits != 0U; bits &= bits - 1U) {
+        auto button = std::countr_zero(bits);
+        if (padButtonCounts[button] > 0 && --padButtonCounts[button] == 0) released |= 1U << button;
+    }
+    padChordMask.fetch_and(~released);
+}
+
+Equipset* EquipsetManager::SearchEquipsetByChord(const uint32_t& _hotkey, bool _modifier1, bool _modifier2,
+                                                 bool _modifier3, Equipset::GESTURE _gesture,
+                                                 const uint32_t& _leader, const uint32_t& _layer,
+                                                 const uint32_t& _padMask) {
+    if (_hotkey == 0) return nullptr;
+
+    auto token = GetChordKey(_hotkey, _modifier1, _modifier2, _modifier3, _padMask);
+    auto leader = _leader != 0 ? GetChordKey(_leader, false, false, false) : 0U;
+
+    return Resolve(GetLayer(_layer)->Search(token, leader, _gesture));
+}
+
+bool EquipsetManager::IsLayerChord(const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3,
+                                   const uint32_t& _padMask) {
+    auto config = ConfigHandler::GetSingleton();
+    if (!config || config->Settings.layerHotkey == 0) return false;
+
+    // The layer switch is the bare key; with a modifier or pad chord held the key reaches equipset bindings.
+    return _hotkey == config->Settings.layerHotkey && !_modifier1 && !_modifier2 && !_modifier3 && _padMask == 0U;
+}
+
+void EquipsetManager::AddName(Equipset* _equipset) {
+    nameMap.try_emplace(_equipset->name, _equipset);
+}
+
+void EquipsetManager::RemoveName(Equipset* _equipset) {
+    auto it = nameMap.find(_equipset->name);
+    if (it == nameMap.end() || it->second != _equipset) return;
+    nameMap.erase(it);
+
+    // Imported files may carry duplicate names; hand the entry to the next holder.
+    for (auto elem : equipsetVec) {
+        if (elem != _equipset && elem->name == _equipset->name) {
+            nameMap.try_emplace(elem->name, elem);
+            return;
+        }
+    }
+
+    // A freed preset name lowers its prefix's counter so the next preset reuses it.
+    for (auto& [prefix, suffix] : presetSuffixMap) {
+        std::string_view name = _equipset->name;
+        if (!name.starts_with(prefix)) continue;
+
+        name.remove_prefix(prefix.size());
+        uint32_t value = 0U;
+        auto [ptr, ec] = std::from_chars(name.data(), name.data() + name.size(), value);
+        if (ec == std::errc() && ptr == name.data() + name.size() && value != 0 && value < suffix) {
+            suffix = value;
+        }
+    }
+}
+
+void EquipsetManager::Rename(Equipset* _equipset, const std::string& _name) {
+    if (!_equipset || _equipset->name == _name) return;
+
+    RemoveName(_equipset);
+    _equipset->name = _name;
+    AddName(_equipset);
+    _equipset->MarkDirty();
+}
 
 std::string EquipsetManager::GetNamePreset() {
 	auto ts = Translator::GetSingleton();
 	if (!ts) return "";
 
-	std::string result = TRANSLATE("_EQUIPSET_NAME_PRESET");
+	std::string prefix = TRANSLATE("_EQUIPSET_NAME_PRESET");
 
-	int suffix = 1;
-    while (true) {
-		bool next = false;
-        for (int i = 0; i < equipsetVec.size(); i++) {
-            if (equipsetVec[i]->name == fmt::format("{}{}", result, suffix)) {
-                next = true;
-            }
-        }
+    auto [it, inserted] = presetSuffixMap.try_emplace(prefix, 1U);
+    auto& suffix = it->second;
 
-		if (!next) {
-            result = fmt::format("{}{}", result, suffix);
-			break;
-		}
-		suffix++;
+    std::string result = fmt::format("{}{}", prefix, suffix);
+    while (nameMap.contains(result)) {
+        result = fmt::format("{}{}", prefix, ++suffix);
     }
 
 	return result;
@@ -103,26 +366,28 @@ std::string EquipsetManager::GetNamePreset() {
 std::pair<EquipsetManager::VALID_TYPE, std::string> EquipsetManager::IsCreateValid(const std::string& _name,
                                                                                    const uint32_t& _hotkey,
                                                                                    bool _modifier1, bool _modifier2,
-                                                                                   bool _modifier3) {
+                                                                                   bool _modifier3,
+                                                                                   Equipset::GESTURE _gesture,
+                                                                                   const uint32_t& _leader,
+                                                                                   const uint32_t& _layer,
+                                                                                   const uint32_t& _padMask) {
     if (_name == "") {
         return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::NAME_BLANK, "");
     }
 
-    for (auto equipset : equipsetVec) {
-        if (equipset->name == _name) {
-            return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::NAME_CONFLICT, (std::string)_name);
-        }
+    if (nameMap.contains(_name)) {
+        return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::NAME_CONFLICT, (std::string)_name);
     }
 
-    if (_hotkey != 0) {
-        for (auto equipset : equipsetVec) {
-            if (equipset->hotkey == _hotkey &&
-                equipset->modifier1 == _modifier1 &&
-                equipset->modifier2 == _modifier2 &&
-                equipset->modifier3 == _modifier3) {
-                return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::HOTKEY_CONFLICT, (std::string)equipset->name);
-            }
-        }
+    auto ts = Translator::GetSingleton();
+    if (ts && IsLayerChord(_hotkey, _modifier1, _modifier2, _modifier3, _padMask)) {
+        return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::HOTKEY_CONFLICT,
+                                                       TRANSLATE("_TAB_CONFIG_SETTINGS_LAYERHOTKEY"));
+    }
+
+    auto found = SearchEquipsetByChord(_hotkey, _modifier1, _modifier2, _modifier3, _gesture, _leader, _layer, _padMask);
+    if (found) {
+        return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::HOTKEY_CONFLICT, (std::string)found->name);
     }
 
     return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::GOOD, "");
@@ -132,29 +397,29 @@ std::pair<EquipsetManager::VALID_TYPE, std::string> EquipsetManager::IsEditValid
                                                                                  const std::string& _name,
                                                                                  const uint32_t& _hotkey,
                                                                                  bool _modifier1, bool _modifier2,
-                                                                                 bool _modifier3) {
+                                                                                 bool _modifier3,
+                                                                                 Equipset::GESTURE _gesture,
+                                                                                 const uint32_t& _leader,
+                                                                                 const uint32_t& _layer,
+                                                                                 const uint32_t& _padMask) {
     if (_name == "") {
         return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::NAME_BLANK, "");
     }
 
-    for (auto equipset : equipsetVec) {
-        if (equipset == _equipset) continue;
-
-        if (equipset->name == _name) {
-            return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::NAME_CONFLICT, (std::string)_name);
-        }
+    auto named = SearchEquipsetByName(_name);
+    if (named && named != _equipset) {
+        return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::NAME_CONFLICT, (std::string)_name);
     }
 
-    if (_hotkey != 0) {
-        for (auto equipset : equipsetVec) {
-            if (equipset == _equipset) continue;
+    auto ts = Translator::GetSingleton();
+    if (ts && IsLayerChord(_hotkey, _modifier1, _modifier2, _modifier3, _padMask)) {
+        return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::HOTKEY_CONFLICT,
+                                                       TRANSLATE("_TAB_CONFIG_SETTINGS_LAYERHOTKEY"));
+    }
 
-            if (equipset->hotkey == _hotkey && equipset->modifier1 == _modifier1 && equipset->modifier2 == _modifier2 &&
-                equipset->modifier3 == _modifier3) {
-                return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::HOTKEY_CONFLICT,
-                                                               (std::string)equipset->name);
-            }
-        }
+    auto found = SearchEquipsetByChord(_hotkey, _modifier1, _modifier2, _modifier3, _gesture, _leader, _layer, _padMask);
+    if (found && found != _equipset) {
+        return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::HOTKEY_CONFLICT, (std::string)found->name);
     }
 
     return std::make_pair<VALID_TYPE, std::string>(VALID_TYPE::GOOD, "");
@@ -174,6 +439,10 @@ uint32_t EquipsetManager::AssignSortOrder() {
     return value;
 }
 
+void EquipsetManager::MaterializeAll() {
+    Cosave::Materialize(equipsetVec);
+}
+
 void EquipsetManager::SyncSortOrder() {
     uint32_t MAX = 0;
     for (auto equipset : equipsetVec) {
@@ -185,132 +454,188 @@ void EquipsetManager::SyncSortOrder() {
     sortOrderHolder = MAX + 1;
 }
 
-void EquipsetManager::ProcessEquip(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3) {
-    auto gui = GuiMenu::GetSingleton();
-    if (!gui) return;
+uint32_t EquipsetManager::GetLayerCount() {
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return 1U;
 
-    auto UI = RE::UI::GetSingleton();
-    if (!UI) return;
+    auto count = std::max<size_t>(config->Settings.layers.size(), layers.size());
+    return static_cast<uint32_t>(std::max<size_t>(count, 1));
+}
 
-    auto intfcStr = RE::InterfaceStrings::GetSingleton();
-    if (!intfcStr) return;
+void EquipsetManager::SetActiveLayer(const uint32_t& _layer) {
+    if (_layer >= GetLayerCount()) return;
 
-    if (UI->GameIsPaused() ||
-        UI->IsMenuOpen(intfcStr->mapMenu) ||
-        UI->IsMenuOpen(intfcStr->inventoryMenu) ||
-        UI->IsMenuOpen(intfcStr->magicMenu) ||
-        UI->IsMenuOpen(intfcStr->tweenMenu) ||
-        UI->IsMenuOpen(intfcStr->dialogueMenu) ||
-        UI->IsMenuOpen(intfcStr->barterMenu) ||
-        UI->IsMenuOpen(intfcStr->craftingMenu) ||
-        UI->IsMenuOpen(intfcStr->containerMenu) ||
-        UI->IsMenuOpen(intfcStr->console) ||
-        UI->IsMenuOpen("LootMenu")) return;
+    auto prevLayer = GetLayer(activeLayerIndex);
+    auto nextLayer = GetLayer(_layer);
+    if (prevLayer == nextLayer) return;
 
-    if (gui->isShow()) return;
+    auto widgetHandler = WidgetHandler::GetSingleton();
+    if (!widgetHandler) return;
 
-    for (auto equipset : equipsetVec) {
-        if (equipset->hotkey == _code &&
-            equipset->modifier1 == _modifier1 &&
-            equipset->modifier2 == _modifier2 &&
-            equipset->modifier3 == _modifier3) {
-            if (equipset->type != Equipset::TYPE::CYCLE) {
-                equipset->Equip();
-                return;
-            }
-
-            auto cycleset = static_cast<CycleSet*>(equipset);
-            if (cycleset->cycleExpire != 0.0f) {
-                if (cycleset->cycleExpireProgress != 0.0f && cycleset->cycleExpireProgress.load() < cycleset->cycleExpire) {
-                    cycleset->SetExpireProgress(0.01f);
-                } else {
-                    cycleset->StartExpireTimer();
-                }
-            }
-
-            if (cycleset->cycleReset != 0.0f) {
-                if (cycleset->cycleResetProgress != 0.0f && cycleset->cycleResetProgress.load() < cycleset->cycleReset) {
-                    cycleset->SetResetProgress(0.01f);
-                } else {
-                    cycleset->StartResetTimer();
-                }
-            } else {
-                cycleset->Equip();
-            }
+    // Swap both layers' widgets in one widget menu task instead of a full reload.
+    widgetHandler->BeginBatch();
+    for (auto elem : layerSets[activeLayerIndex]) {
+        elem->RemoveWidget();
+        if (elem->gesture == Equipset::GESTURE::HOLD) SetHoldKeyBit(elem->hotkey, false);
+    }
 
-            return;
+    prevLayer->ResetState();
+    activeLayerIndex = _layer;
+    activeLayer.store(nextLayer);
+
+    for (auto elem : layerSets[activeLayerIndex]) {
+        elem->CreateWidget();
+        if (elem->gesture == Equipset::GESTURE::HOLD && elem->hotkey != 0) SetHoldKeyBit(elem->hotkey, true);
+    }
+    widgetHandler->EndBatch();
+}
+
+void EquipsetManager::Activate(Equipset* _equipset, bool _isPress) {
+    if (!_equipset) return;
+
+    _equipset->Materialize();
+
+    if (_equipset->type != Equipset::TYPE::CYCLE) {
+        _equipset->Equip();
+        return;
+    }
+
+    auto cycleset = static_cast<CycleSet*>(_equipset);
+    if (cycleset->cycleExpire != 0.0f) {
+        if (cycleset->cycleExpireProgress != 0.0f && cycleset->cycleExpireProgress.load() < cycleset->cycleExpire) {
+            cycleset->SetExpireProgress(0.01f);
+        } else {
+            cycleset->StartExpireTimer();
         }
     }
+
+    // The reset timer is closed by the matching release, which only a plain press binding gets.
+    if (_isPress && cycleset->cycleReset != 0.0f) {
+        if (cycleset->cycleResetProgress != 0.0f && cycleset->cycleResetProgress.load() < cycleset->cycleReset) {
+            cycleset->SetResetProgress(0.01f);
+        } else {
+            cycleset->StartResetTimer();
+        }
+    } else {
+        cycleset->Equip();
+    }
 }
 
-void EquipsetManager::CalculateKeydown(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3, float _time) {
+static bool IsDispatchBlocked() {
     auto gui = GuiMenu::GetSingleton();
-    if (!gui) return;
+    if (!gui) return true;
 
     auto UI = RE::UI::GetSingleton();
-    if (!UI) return;
+    if (!UI) return true;
 
-    auto intfcStr = RE::InterfaceStrings::GetSingleton();
-    if (!intfcStr) return;
+    auto hud = HUDHandler::GetSingleton();
+    if (!hud) return true;
 
-    if (UI->GameIsPaused() ||
-        UI->IsMenuOpen(intfcStr->mapMenu) ||
-        UI->IsMenuOpen(intfcStr->inventoryMenu) ||
-        UI->IsMenuOpen(intfcStr->magicMenu) ||
-        UI->IsMenuOpen(intfcStr->tweenMenu) ||
-        UI->IsMenuOpen(intfcStr->dialogueMenu) ||
-        UI->IsMenuOpen(intfcStr->barterMenu) ||
-        UI->IsMenuOpen(intfcStr->craftingMenu) ||
-        UI->IsMenuOpen(intfcStr->containerMenu) ||
-        UI->IsMenuOpen(intfcStr->console) ||
-        UI->IsMenuOpen("LootMenu")) return;
+    if (UI->GameIsPaused() || hud->IsBlockMenuOpen()) return true;
 
-    if (gui->isShow()) return;
+    return gui->isShow();
+}
 
-    for (auto equipset : equipsetVec) {
-        if (equipset->hotkey == _code &&
-            equipset->modifier1 == _modifier1 &&
-            equipset->modifier2 == _modifier2 &&
-            equipset->modifier3 == _modifier3) {
-            if (equipset->type != Equipset::TYPE::CYCLE) return;
-
-            auto cycleset = static_cast<CycleSet*>(equipset);
-            if (cycleset->cycleReset != 0.0f && _time < cycleset->cycleReset) {
-                cycleset->CloseResetTimer();
-                cycleset->Equip();
-            }
+void EquipsetManager::ProcessEquip(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3,
+                                   const uint32_t& _padMask) {
+    if (IsDispatchBlocked()) return;
 
-            return;
-        }
+    if (IsLayerChord(_code, _modifier1, _modifier2, _modifier3, _padMask)) {
+        SetActiveLayer((activeLayerIndex + 1) % GetLayerCount());
+        return;
+    }
+
+    auto automaton = activeLayer.load();
+    if (!automaton) {
+        automaton = GetLayer(activeLayerIndex);
+        activeLayer.store(automaton);
     }
+
+    auto equipset = Resolve(automaton->Press(GetChordKey(_code, _modifier1, _modifier2, _modifier3, _padMask)));
+    if (!equipset) return;
+
+    Activate(equipset, equipset->gesture == Equipset::GESTURE::PRESS);
 }
 
-Equipset* EquipsetManager::SearchEquipsetByName(const std::string& _name) {
-    for (auto elem : equipsetVec) {
-        if (elem->name == _name) {
-            return elem;
-        }
+void EquipsetManager::ProcessHeld(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3,
+                                  float _time) {
+    if (IsDispatchBlocked()) return;
+
+    auto automaton = activeLayer.load();
+    if (!automaton) return;
+
+    auto equipset = Resolve(automaton->Held(GetChordKey(_code, _modifier1, _modifier2, _modifier3), _time));
+    if (!equipset) return;
+
+    Activate(equipset, false);
+}
+
+void EquipsetManager::CalculateKeydown(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3, float _time) {
+    if (IsDispatchBlocked()) return;
+
+    auto automaton = activeLayer.load();
+    if (!automaton) return;
+
+    auto [fire, release] = automaton->Release(GetChordKey(_code, _modifier1, _modifier2, _modifier3), _time);
+    if (fire) Activate(Resolve(fire), false);
+
+    auto cycleset = cyclePool.Get(release);
+    if (!cycleset) return;
+
+    if (cycleset->cycleReset != 0.0f && _time < cycleset->cycleReset) {
+        cycleset->CloseResetTimer();
+        cycleset->Equip();
     }
+}
+
+Equipset* EquipsetManager::SearchEquipsetByName(std::string_view _name) {
+    auto it = nameMap.find(_name);
+    if (it == nameMap.end()) return nullptr;
 
-    return nullptr;
+    return it->second;
 }
 
 void EquipsetManager::ImportEquipsets() {
-    Serialize::ImportEquipset(Serialize::Type::FILE);
+    // Parse on the calling thread (and its workers), then swap the sets in on the game thread.
+    auto batch = std::make_shared<Serialize::ImportBatch>();
+    if (!Serialize::ParseEquipset(Serialize::Type::FILE, *batch)) return;
+
+    auto task = SKSE::GetTaskInterface();
+    if (!task) {
+        logger::error("Failed to get task interface.");
+        return;
+    }
+
+    task->AddTask([batch]() {
+        auto manager = EquipsetManager::GetSingleton();
+        if (!manager) return;
+
+        manager->RemoveAllWidget();
+        manager->RemoveAll();
+        Serialize::CommitEquipset(*batch);
+        manager->SyncSortOrder();
+    });
 }
 
 void EquipsetManager::ExportEquipsets() {
-    Serialize::ExportEquipset(Serialize::Type::FILE);
+    // The sets are captured on the game thread; encoding and the disk write happen on the file writer.
+    auto task = SKSE::GetTaskInterface();
+    if (!task) {
+        logger::error("Failed to get task interface.");
+        return;
+    }
+
+    task->AddTask([]() { Serialize::ExportEquipset(); });
 }
 
 void EquipsetManager::CreateAllWidget() {
-    for (auto elem : equipsetVec) {
-        elem->CreateWidget();
-    }
+    normalPool.ForEach([](NormalSet& _equipset) { _equipset.CreateWidget(); });
+    potionPool.ForEach([](PotionSet& _equipset) { _equipset.CreateWidget(); });
+    cyclePool.ForEach([](CycleSet& _cycleset) { _cycleset.CreateWidget(); });
 }
 
 void EquipsetManager::RemoveAllWidget() {
-    for (auto elem : equipsetVec) {
-        elem->RemoveWidget();
-    }
+    normalPool.ForEach([](NormalSet& _equipset) { _equipset.RemoveWidget(); });
+    potionPool.ForEach([](PotionSet& _equipset) { _equipset.RemoveWidget(); });
+    cyclePool.ForEach([](CycleSet& _cycleset) { _cycleset.RemoveWidget(); });
 }
\ No newline at end of file
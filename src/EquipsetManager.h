@@ -1,12 +1,87 @@
 #pragma once
 
 #include "Equipset.h"
+#include "ChordAutomaton.h"
+#include "EquipsetPool.h"
 
 class EquipsetManager {
 private:
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view _name) const { return std::hash<std::string_view>{}(_name); }
+    };
+    template <class T>
+    using NameMap = std::unordered_map<std::string, T, NameHash, std::equal_to<>>;
+
     uint32_t widgetIndexHolder{1U};
     uint32_t sortOrderHolder{1U};
 
+    EquipsetPool<NormalSet, Equipset::TYPE::NORMAL> normalPool;
+    EquipsetPool<PotionSet, Equipset::TYPE::POTION> potionPool;
+    EquipsetPool<CycleSet, Equipset::TYPE::CYCLE> cyclePool;
+
+    // One automaton per binding layer; dispatch only reads the active one.
+    std::vector<std::unique_ptr<ChordAutomaton>> layers;
+    std::atomic<ChordAutomaton*> activeLayer{nullptr};
+    uint32_t activeLayerIndex{0U};
+    // The sets of each layer, bound or not, so a layer switch only touches the two layers it swaps.
+    std::vector<std::vector<Equipset*>> layerSets;
+
+    ChordAutomaton* GetLayer(const uint32_t& _layer);
+    void AddToLayer(Equipset* _equipset);
+    void RemoveFromLayer(Equipset* _equipset);
+
+    // A gesture slot of one layer's automaton.
+    struct ChordId {
+        uint64_t token;
+        uint64_t leader;
+        uint32_t layer;
+        Equipset::GESTURE gesture;
+
+        bool operator==(const ChordId&) const = default;
+    };
+    struct ChordIdHash {
+        size_t operator()(const ChordId& _id) const {
+            auto hash = std::hash<uint64_t>{}(_id.token);
+            hash ^= std::hash<uint64_t>{}(_id.leader) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+            return hash ^ std::hash<uint64_t>{}((static_cast<uint64_t>(_id.layer) << 2) |
+                                                static_cast<uint64_t>(_id.gesture));
+        }
+    };
+    static ChordId GetChordId(Equipset* _equipset);
+
+    // Key: a taken chord
+    // Value: sets left unbound on it, in the order they asked for it
+    std::unordered_map<ChordId, std::vector<Equipset*>, ChordIdHash> unboundMap;
+
+    // Union of every binding's required gamepad buttons; held buttons outside it are ignored.
+    std::atomic<uint32_t> padChordMask{0U};
+    // Number of sets requiring each gamepad button; a button stays in padChordMask while its count is nonzero.
+    std::array<uint32_t, 32> padButtonCounts{};
+    void AddPadButtons(const uint32_t& _padMask);
+    void RemovePadButtons(const uint32_t& _padMask);
+
+    // Bit: hotkey with a hold binding on the active layer; the input sink only sends held repeats for these.
+    static constexpr uint32_t holdKeyLimit{1024U};
+    std::array<std::atomic<uint64_t>, holdKeyLimit / 64U> holdKeyMask{};
+    // Key: layer in the upper half, hotkey in the lower half
+    // Value: number of hold bindings on it
+    std::unordered_map<uint64_t, uint32_t> holdKeyCounts;
+    void AddHoldKey(Equipset* _equipset);
+    void RemoveHoldKey(Equipset* _equipset);
+    void SetHoldKeyBit(const uint32_t& _hotkey, bool _isSet);
+
+    void Activate(Equipset* _equipset, bool _isPress);
+
+    // Key: equipset name
+    NameMap<Equipset*> nameMap;
+    // Key: name preset prefix
+    // Value: lowest suffix that may still be free; every suffix below it is taken
+    NameMap<uint32_t> presetSuffixMap;
+
+    void AddName(Equipset* _equipset);
+    void RemoveName(Equipset* _equipset);
+
 public:
     std::vector<Equipset*> equipsetVec;
 
@@ -17,25 +92,54 @@ public:
         NAME_CONFLICT,
         HOTKEY_CONFLICT
     };
-    void Create(const NormalSet& _equipset, bool _assignOrder);
-    void Create(const PotionSet& _equipset, bool _assignOrder);
-    void Create(const CycleSet& _equipset, bool _assignOrder);
+    void Create(NormalSet&& _equipset, bool _assignOrder);
+    void Create(PotionSet&& _equipset, bool _assignOrder);
+    void Create(CycleSet&& _equipset, bool _assignOrder);
+    Equipset* Resolve(const uint32_t& _handle);
     void Remove(Equipset* _equipset);
     void RemoveAll();
+    bool AddChord(Equipset* _equipset);
+    void RemoveChord(Equipset* _equipset);
+    void SetChord(Equipset* _equipset, const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3, Equipset::GESTURE _gesture, const uint32_t& _leader, const uint32_t& _layer, const uint32_t& _padMask);
+    void Rename(Equipset* _equipset, const std::string& _name);
+    Equipset* SearchEquipsetByChord(const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3,
+                                    Equipset::GESTURE _gesture, const uint32_t& _leader, const uint32_t& _layer, const uint32_t& _padMask);
+    bool IsLayerChord(const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3, const uint32_t& _padMask);
     std::string GetNamePreset();
-    std::pair<VALID_TYPE, std::string> IsCreateValid(const std::string& _name, const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3);
-    std::pair<VALID_TYPE, std::string> IsEditValid(Equipset* _equipset, const std::string& _name, const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3);
-    void ProcessEquip(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3);
+    std::pair<VALID_TYPE, std::string> IsCreateValid(const std::string& _name, const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3, Equipset::GESTURE _gesture, const uint32_t& _leader, const uint32_t& _layer, const uint32_t& _padMask);
+    std::pair<VALID_TYPE, std::string> IsEditValid(Equipset* _equipset, const std::string& _name, const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3, Equipset::GESTURE _gesture, const uint32_t& _leader, const uint32_t& _layer, const uint32_t& _padMask);
+    uint32_t GetLayerCount();
+    uint32_t GetActiveLayer() { return activeLayerIndex; }
+    bool IsLayerActive(const uint32_t& _layer) { return _layer == activeLayerIndex; }
+    void SetActiveLayer(const uint32_t& _layer);
+    uint32_t GetPadChordMask() { return padChordMask.load(std::memory_order_relaxed); }
+    bool IsHoldKey(const uint32_t& _hotkey) {
+        if (_hotkey >= holdKeyLimit) return true;
+
+        return holdKeyMask[_hotkey / 64U].load(std::memory_order_relaxed) & (1ULL << (_hotkey % 64U));
+    }
+    void ProcessEquip(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3, const uint32_t& _padMask);
+    void ProcessHeld(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3, float _time);
     void CalculateKeydown(const uint32_t& _code, bool _modifier1, bool _modifier2, bool _modifier3, float _time);
-    Equipset* SearchEquipsetByName(const std::string& _name);
+    Equipset* SearchEquipsetByName(std::string_view _name);
     void ExportEquipsets();
     void ImportEquipsets();
+    void MaterializeAll();
     void SyncSortOrder();
     void CreateAllWidget();
     void RemoveAllWidget();
     uint32_t AssignWidgetID();
     uint32_t AssignSortOrder();
 
+    // Bits 0-2: modifiers, 3-34: hotkey, 35-52: held gamepad buttons (InputHandler::GetPadIndex)
+    static uint64_t GetChordKey(const uint32_t& _hotkey, bool _modifier1, bool _modifier2, bool _modifier3,
+                                const uint32_t& _padMask = 0U) {
+        return (static_cast<uint64_t>(_padMask) << 35) | (static_cast<uint64_t>(_hotkey) << 3) |
+               (_modifier1 ? 1U : 0U) | (_modifier2 ? 2U : 0U) | (_modifier3 ? 4U : 0U);
+    }
+
+    static uint32_t GetChordHotkey(const uint64_t& _token) { return static_cast<uint32_t>(_token >> 3); }
+
 public:
     static EquipsetManager* GetSingleton() {
         static EquipsetManager singleton;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Equipset.h"
+
+// Handle layout: bits 0-15 slot index, 16-29 generation, 30-31 Equipset::TYPE.
+// Generations start at 1, so a valid handle is never 0.
+namespace EquipsetHandle {
+    inline constexpr uint32_t invalid{0U};
+    inline constexpr uint32_t indexBits{16U};
+    inline constexpr uint32_t generationBits{14U};
+    inline constexpr uint32_t indexMask{(1U << indexBits) - 1U};
+    inline constexpr uint32_t generationMask{(1U << generationBits) - 1U};
+
+    constexpr uint32_t Make(Equipset::TYPE _type, const uint32_t& _index, const uint32_t& _generation) {
+        return (static_cast<uint32_t>(_type) << (indexBits + generationBits)) | (_generation << indexBits) | _index;
+    }
+    constexpr Equipset::TYPE GetType(const uint32_t& _handle) {
+        return static_cast<Equipset::TYPE>(_handle >> (indexBits + generationBits));
+    }
+    constexpr uint32_t GetIndex(const uint32_t& _handle) { return _handle & indexMask; }
+    constexpr uint32_t GetGeneration(const uint32_t& _handle) { return (_handle >> indexBits) & generationMask; }
+}
+
+// Per-type slot map. Slots live in a deque, so addresses stay stable while the pool grows and
+// a freed slot is reused in place; a stale handle fails the generation check instead of dangling.
+template <class T, Equipset::TYPE Type>
+class EquipsetPool {
+public:
+    uint32_t Insert(T&& _value) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slots.size() > EquipsetHandle::indexMask) return EquipsetHandle::invalid;
+
+            index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+
+        auto& slot = slots[index];
+        slot.value = std::move(_value);
+        slot.isAlive = true;
+        ++count;
+
+        auto handle = EquipsetHandle::Make(Type, index, slot.generation);
+        slot.value.handle = handle;
+        return handle;
+    }
+
+    T* Get(const uint32_t& _handle) {
+        if (EquipsetHandle::GetType(_handle) != Type) return nullptr;
+
+        auto index = EquipsetHandle::GetIndex(_handle);
+        if (index >= slots.size()) return nullptr;
+
+        auto& slot = slots[index];
+        if (!slot.isAlive || slot.generation != EquipsetHandle::GetGeneration(_handle)) return nullptr;
+
+        return std::addressof(slot.value);
+    }
+
+    bool Erase(const uint32_t& _handle) {
+        if (!Get(_handle)) return false;
+
+        auto index = EquipsetHandle::GetIndex(_handle);
+        Release(slots[index]);
+        freeSlots.push_back(static_cast<uint16_t>(index));
+        return true;
+    }
+
+    void Clear() {
+        freeSlots.clear();
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (slots[i].isAlive) Release(slots[i]);
+            freeSlots.push_back(static_cast<uint16_t>(slots.size() - 1 - i));
+        }
+    }
+
+    template <class Func>
+    void ForEach(Func&& _func) {
+        if (count == 0) return;
+
+        for (auto& slot : slots) {
+            if (slot.isAlive) _func(slot.value);
+        }
+    }
+
+    uint32_t Size() const { return count; }
+
+private:
+    struct Slot {
+        T value;
+        uint16_t generation{1U};
+        bool isAlive{false};
+    };
+
+    std::deque<Slot> slots;
+    std::vector<uint16_t> freeSlots;
+    uint32_t count{0U};
+
+    void Release(Slot& _slot) {
+        // Rebuild the slot so its strings and vectors are freed now rather than on reuse.
+        std::destroy_at(std::addressof(_slot.value));
+        std::construct_at(std::addressof(_slot.value));
+
+        _slot.isAlive = false;
+        _slot.generation = _slot.generation == EquipsetHandle::generationMask ? 1U : _slot.generation + 1U;
+        --count;
+    }
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Config.h"
 #include "EquipsetManager.h"
 #include "WidgetHandler.h"
+#include "InventorySnapshot.h"
 
 void ContainerHandler::Register() {
     auto source = RE::ScriptEventSourceHolder::GetSingleton();
@@ -21,6 +22,9 @@ ContainerHandler::EventResult ContainerHandler::ProcessEvent(
     if (_event->newContainer != 0x14 && _event->oldContainer != 0x14) return EventResult::kContinue;
     bool isAdded = _event->newContainer == 0x14;
 
+    auto snapshot = InventorySnapshot::GetSingleton();
+    if (snapshot) snapshot->MarkDirty(_event->baseObj);
+
     auto form = RE::TESForm::LookupByID(_event->baseObj);
     if (!form) return EventResult::kContinue;
     
@@ -43,7 +47,7 @@ ContainerHandler::EventResult ContainerHandler::ProcessEvent(
         if (equipset->type != Equipset::TYPE::POTION) continue;
         
         auto potionset = static_cast<PotionSet*>(equipset);
-        if (!potionset) continue;
+        if (!potionset || !potionset->IsMaterialized()) continue;
 
         potionset->AssignAutoPotion();
 
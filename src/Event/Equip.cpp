@@ -1,6 +1,7 @@
 #include "Equip.h"
 #include "Equipment.h"
 #include "WidgetHandler.h"
+#include "InventorySnapshot.h"
 
 void EquipHandler::Register() {
     auto source = RE::ScriptEventSourceHolder::GetSingleton();
@@ -23,6 +24,11 @@ EquipHandler::EventResult EquipHandler::ProcessEvent(const RE::TESEquipEvent* _e
     if (actor->GetFormID() != 0x14) return EventResult::kContinue;
 
     auto formID = _event->baseObject;
+
+    // Equipping moves the worn flag between extra data lists, possibly splitting a stack.
+    auto snapshot = InventorySnapshot::GetSingleton();
+    if (snapshot) snapshot->MarkDirty(formID);
+
     auto form = RE::TESForm::LookupByID<RE::TESForm>(formID);
     if (form) {
         auto equipment = EquipmentManager::GetSingleton();
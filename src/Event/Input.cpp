@@ -1,130 +1,148 @@
 #include "Input.h"
 #include "Config.h"
+#include "InputQueue.h"
+#include "InputRecorder.h"
 #include "EquipsetManager.h"
 
 #include <imgui.h>
 
-InputHandler::InputHandler() {
-    // Key: scan_code
+namespace {
+    // Index: DirectInput scan code
+    // Value: ImGuiKey
+    constexpr auto defaultKeyTable = []() {
+        InputHandler::KeyTable table{};
+        table[1] = ImGuiKey_Escape;
+        table[2] = ImGuiKey_1;
+        table[3] = ImGuiKey_2;
+        table[4] = ImGuiKey_3;
+        table[5] = ImGuiKey_4;
+        table[6] = ImGuiKey_5;
+        table[7] = ImGuiKey_6;
+        table[8] = ImGuiKey_7;
+        table[9] = ImGuiKey_8;
+        table[10] = ImGuiKey_9;
+        table[11] = ImGuiKey_0;
+        table[12] = ImGuiKey_Minus;
+        table[13] = ImGuiKey_Equal;
+        table[14] = ImGuiKey_Backspace;
+        table[15] = ImGuiKey_Tab;
+        table[16] = ImGuiKey_Q;
+        table[17] = ImGuiKey_W;
+        table[18] = ImGuiKey_E;
+        table[19] = ImGuiKey_R;
+        table[20] = ImGuiKey_T;
+        table[21] = ImGuiKey_Y;
+        table[22] = ImGuiKey_U;
+        table[23] = ImGuiKey_I;
+        table[24] = ImGuiKey_O;
+        table[25] = ImGuiKey_P;
+        table[26] = ImGuiKey_LeftBracket;
+        table[27] = ImGuiKey_RightBracket;
+        table[28] = ImGuiKey_Enter;
+        table[29] = ImGuiKey_ModCtrl;
+        table[30] = ImGuiKey_A;
+        table[31] = ImGuiKey_S;
+        table[32] = ImGuiKey_D;
+        table[33] = ImGuiKey_F;
+        table[34] = ImGuiKey_G;
+        table[35] = ImGuiKey_H;
+        table[36] = ImGuiKey_J;
+        table[37] = ImGuiKey_K;
+        table[38] = ImGuiKey_L;
+        table[39] = ImGuiKey_Semicolon;
+        table[40] = ImGuiKey_Apostrophe;
+        table[41] = ImGuiKey_GraveAccent;
+        table[42] = ImGuiKey_ModShift;
+        table[43] = ImGuiKey_Backslash;
+        table[44] = ImGuiKey_Z;
+        table[45] = ImGuiKey_X;
+        table[46] = ImGuiKey_C;
+        table[47] = ImGuiKey_V;
+        table[48] = ImGuiKey_B;
+        table[49] = ImGuiKey_N;
+        table[50] = ImGuiKey_M;
+        table[51] = ImGuiKey_Comma;
+        table[52] = ImGuiKey_Period;
+        table[53] = ImGuiKey_Slash;
+        table[54] = ImGuiKey_RightShift;
+        table[55] = ImGuiKey_KeypadMultiply;
+        table[56] = ImGuiKey_ModAlt;
+        table[57] = ImGuiKey_Space;
+        table[58] = ImGuiKey_CapsLock;
+        table[59] = ImGuiKey_F1;
+        table[60] = ImGuiKey_F2;
+        table[61] = ImGuiKey_F3;
+        table[62] = ImGuiKey_F4;
+        table[63] = ImGuiKey_F5;
+        table[64] = ImGuiKey_F6;
+        table[65] = ImGuiKey_F7;
+        table[66] = ImGuiKey_F8;
+        table[67] = ImGuiKey_F9;
+        table[68] = ImGuiKey_F10;
+        table[69] = ImGuiKey_NumLock;
+        table[70] = ImGuiKey_ScrollLock;
+        table[71] = ImGuiKey_Keypad7;
+        table[72] = ImGuiKey_Keypad8;
+        table[73] = ImGuiKey_Keypad9;
+        table[74] = ImGuiKey_KeypadSubtract;
+        table[75] = ImGuiKey_Keypad4;
+        table[76] = ImGuiKey_Keypad5;
+        table[77] = ImGuiKey_Keypad6;
+        table[78] = ImGuiKey_KeypadAdd;
+        table[79] = ImGuiKey_Keypad1;
+        table[80] = ImGuiKey_Keypad2;
+        table[81] = ImGuiKey_Keypad3;
+        table[82] = ImGuiKey_Keypad0;
+        table[83] = ImGuiKey_KeypadDecimal;
+        table[87] = ImGuiKey_F11;
+        table[88] = ImGuiKey_F12;
+        table[156] = ImGuiKey_KeypadEnter;
+        table[157] = ImGuiKey_RightCtrl;
+        table[181] = ImGuiKey_KeypadDivide;
+        table[183] = ImGuiKey_PrintScreen;
+        table[184] = ImGuiKey_RightAlt;
+        table[197] = ImGuiKey_Pause;
+        table[199] = ImGuiKey_Home;
+        table[200] = ImGuiKey_UpArrow;
+        table[201] = ImGuiKey_PageUp;
+        table[203] = ImGuiKey_LeftArrow;
+        table[205] = ImGuiKey_RightArrow;
+        table[207] = ImGuiKey_End;
+        table[208] = ImGuiKey_DownArrow;
+        table[209] = ImGuiKey_PageDown;
+        table[210] = ImGuiKey_Insert;
+        table[211] = ImGuiKey_Delete;
+        return table;
+    }();
+
+    // Index: InputHandler::GetPadIndex(button mask)
     // Value: ImGuiKey
-    keyMap[1] = ImGuiKey_Escape;
-    keyMap[2] = ImGuiKey_1;
-    keyMap[3] = ImGuiKey_2;
-    keyMap[4] = ImGuiKey_3;
-    keyMap[5] = ImGuiKey_4;
-    keyMap[6] = ImGuiKey_5;
-    keyMap[7] = ImGuiKey_6;
-    keyMap[8] = ImGuiKey_7;
-    keyMap[9] = ImGuiKey_8;
-    keyMap[10] = ImGuiKey_9;
-    keyMap[11] = ImGuiKey_0;
-    keyMap[12] = ImGuiKey_Minus;
-    keyMap[13] = ImGuiKey_Equal;
-    keyMap[14] = ImGuiKey_Backspace;
-    keyMap[15] = ImGuiKey_Tab;
-    keyMap[16] = ImGuiKey_Q;
-    keyMap[17] = ImGuiKey_W;
-    keyMap[18] = ImGuiKey_E;
-    keyMap[19] = ImGuiKey_R;
-    keyMap[20] = ImGuiKey_T;
-    keyMap[21] = ImGuiKey_Y;
-    keyMap[22] = ImGuiKey_U;
-    keyMap[23] = ImGuiKey_I;
-    keyMap[24] = ImGuiKey_O;
-    keyMap[25] = ImGuiKey_P;
-    keyMap[26] = ImGuiKey_LeftBracket;
-    keyMap[27] = ImGuiKey_RightBracket;
-    keyMap[28] = ImGuiKey_Enter;
-    keyMap[29] = ImGuiKey_ModCtrl;
-    keyMap[30] = ImGuiKey_A;
-    keyMap[31] = ImGuiKey_S;
-    keyMap[32] = ImGuiKey_D;
-    keyMap[33] = ImGuiKey_F;
-    keyMap[34] = ImGuiKey_G;
-    keyMap[35] = ImGuiKey_H;
-    keyMap[36] = ImGuiKey_J;
-    keyMap[37] = ImGuiKey_K;
-    keyMap[38] = ImGuiKey_L;
-    keyMap[39] = ImGuiKey_Semicolon;
-    keyMap[40] = ImGuiKey_Apostrophe;
-    keyMap[41] = ImGuiKey_GraveAccent;
-    keyMap[42] = ImGuiKey_ModShift;
-    keyMap[43] = ImGuiKey_Backslash;
-    keyMap[44] = ImGuiKey_Z;
-    keyMap[45] = ImGuiKey_X;
-    keyMap[46] = ImGuiKey_C;
-    keyMap[47] = ImGuiKey_V;
-    keyMap[48] = ImGuiKey_B;
-    keyMap[49] = ImGuiKey_N;
-    keyMap[50] = ImGuiKey_M;
-    keyMap[51] = ImGuiKey_Comma;
-    keyMap[52] = ImGuiKey_Period;
-    keyMap[53] = ImGuiKey_Slash;
-    keyMap[54] = ImGuiKey_RightShift;
-    keyMap[55] = ImGuiKey_KeypadMultiply;
-    keyMap[56] = ImGuiKey_ModAlt;
-    keyMap[57] = ImGuiKey_Space;
-    keyMap[58] = ImGuiKey_CapsLock;
-    keyMap[59] = ImGuiKey_F1;
-    keyMap[60] = ImGuiKey_F2;
-    keyMap[61] = ImGuiKey_F3;
-    keyMap[62] = ImGuiKey_F4;
-    keyMap[63] = ImGuiKey_F5;
-    keyMap[64] = ImGuiKey_F6;
-    keyMap[65] = ImGuiKey_F7;
-    keyMap[66] = ImGuiKey_F8;
-    keyMap[67] = ImGuiKey_F9;
-    keyMap[68] = ImGuiKey_F10;
-    keyMap[69] = ImGuiKey_NumLock;
-    keyMap[70] = ImGuiKey_ScrollLock;
-    keyMap[71] = ImGuiKey_Keypad7;
-    keyMap[72] = ImGuiKey_Keypad8;
-    keyMap[73] = ImGuiKey_Keypad9;
-    keyMap[74] = ImGuiKey_KeypadSubtract;
-    keyMap[75] = ImGuiKey_Keypad4;
-    keyMap[76] = ImGuiKey_Keypad5;
-    keyMap[77] = ImGuiKey_Keypad6;
-    keyMap[78] = ImGuiKey_KeypadAdd;
-    keyMap[79] = ImGuiKey_Keypad1;
-    keyMap[80] = ImGuiKey_Keypad2;
-    keyMap[81] = ImGuiKey_Keypad3;
-    keyMap[82] = ImGuiKey_Keypad0;
-    keyMap[83] = ImGuiKey_KeypadDecimal;
-    keyMap[87] = ImGuiKey_F11;
-    keyMap[88] = ImGuiKey_F12;
-    keyMap[156] = ImGuiKey_KeypadEnter;
-    keyMap[157] = ImGuiKey_RightCtrl;
-    keyMap[181] = ImGuiKey_KeypadDivide;
-    keyMap[183] = ImGuiKey_PrintScreen;
-    keyMap[184] = ImGuiKey_RightAlt;
-    keyMap[197] = ImGuiKey_Pause;
-    keyMap[199] = ImGuiKey_Home;
-    keyMap[200] = ImGuiKey_UpArrow;
-    keyMap[201] = ImGuiKey_PageUp;
-    keyMap[203] = ImGuiKey_LeftArrow;
-    keyMap[205] = ImGuiKey_RightArrow;
-    keyMap[207] = ImGuiKey_End;
-    keyMap[208] = ImGuiKey_DownArrow;
-    keyMap[209] = ImGuiKey_PageDown;
-    keyMap[210] = ImGuiKey_Insert;
-    keyMap[211] = ImGuiKey_Delete;
-
-    padMap[1] = ImGuiKey_GamepadDpadUp;
-    padMap[2] = ImGuiKey_GamepadDpadDown;
-    padMap[4] = ImGuiKey_GamepadDpadLeft;
-    padMap[8] = ImGuiKey_GamepadDpadRight;
-    padMap[16] = ImGuiKey_GamepadStart;
-    padMap[32] = ImGuiKey_GamepadBack;
-    padMap[64] = ImGuiKey_GamepadL3;
-    padMap[128] = ImGuiKey_GamepadR3;
-    padMap[256] = ImGuiKey_GamepadL1;
-    padMap[512] = ImGuiKey_GamepadR1;
-    padMap[9] = ImGuiKey_GamepadL2;
-    padMap[10] = ImGuiKey_GamepadR2;
-    padMap[4096] = ImGuiKey_GamepadFaceDown;
-    padMap[8192] = ImGuiKey_GamepadFaceRight;
-    padMap[16384] = ImGuiKey_GamepadFaceLeft;
-    padMap[32768] = ImGuiKey_GamepadFaceUp;
+    constexpr auto defaultPadTable = []() {
+        InputHandler::PadTable table{};
+        table[InputHandler::GetPadIndex(1)] = ImGuiKey_GamepadDpadUp;
+        table[InputHandler::GetPadIndex(2)] = ImGuiKey_GamepadDpadDown;
+        table[InputHandler::GetPadIndex(4)] = ImGuiKey_GamepadDpadLeft;
+        table[InputHandler::GetPadIndex(8)] = ImGuiKey_GamepadDpadRight;
+        table[InputHandler::GetPadIndex(16)] = ImGuiKey_GamepadStart;
+        table[InputHandler::GetPadIndex(32)] = ImGuiKey_GamepadBack;
+        table[InputHandler::GetPadIndex(64)] = ImGuiKey_GamepadL3;
+        table[InputHandler::GetPadIndex(128)] = ImGuiKey_GamepadR3;
+        table[InputHandler::GetPadIndex(256)] = ImGuiKey_GamepadL1;
+        table[InputHandler::GetPadIndex(512)] = ImGuiKey_GamepadR1;
+        table[InputHandler::GetPadIndex(9)] = ImGuiKey_GamepadL2;
+        table[InputHandler::GetPadIndex(10)] = ImGuiKey_GamepadR2;
+        table[InputHandler::GetPadIndex(4096)] = ImGuiKey_GamepadFaceDown;
+        table[InputHandler::GetPadIndex(8192)] = ImGuiKey_GamepadFaceRight;
+        table[InputHandler::GetPadIndex(16384)] = ImGuiKey_GamepadFaceLeft;
+        table[InputHandler::GetPadIndex(32768)] = ImGuiKey_GamepadFaceUp;
+        return table;
+    }();
+}  // namespace
+
+InputHandler::InputHandler() {
+    keymapBuffer[0].key = defaultKeyTable;
+    keymapBuffer[0].pad = defaultPadTable;
+    keymap.store(&keymapBuffer[0]);
 }
 
 void InputHandler::Register() {
@@ -134,20 +152,55 @@ void InputHandler::Register() {
     auto input = InputHandler::GetSingleton();
     if (!input) return;
 
+    input->BuildKeymap();
     device->AddEventSink(input);
     logger::info("{} Registered.", typeid(RE::InputEvent).name());
 }
 
+void InputHandler::BuildKeymap() {
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return;
+
+    auto current = keymap.load();
+    auto next = current == &keymapBuffer[0] ? &keymapBuffer[1] : &keymapBuffer[0];
+    next->key = defaultKeyTable;
+    next->pad = defaultPadTable;
+
+    for (const auto& elem : config->keyboardVec) {
+        if (elem.code < next->key.size()) {
+            next->key[elem.code] = elem.key;
+        } else {
+            logger::warn("Invalid keyboard scan code {} in keymap.", elem.code);
+        }
+    }
+
+    for (const auto& elem : config->gamepadVec) {
+        auto index = GetPadIndex(elem.code);
+        if (index < next->pad.size()) {
+            next->pad[index] = elem.key;
+        } else {
+            logger::warn("Invalid gamepad button {} in keymap.", elem.code);
+        }
+    }
+
+    keymap.store(next);
+}
+
+uint32_t InputHandler::GetPadKey(const uint32_t& _index) {
+    auto table = keymap.load(std::memory_order_acquire);
+    return _index < table->pad.size() ? table->pad[_index] : ImGuiKey_None;
+}
+
 uint32_t InputHandler::GetImGuiKey(const uint32_t& _scanCode, RE::INPUT_DEVICE _device) {
-    uint32_t key = 0;
+    auto table = keymap.load(std::memory_order_acquire);
     if (_device == RE::INPUT_DEVICE::kKeyboard) {
-        key = keyMap[_scanCode];
-        if (key == 0) return ImGuiKey_None;
+        return _scanCode < table->key.size() ? table->key[_scanCode] : ImGuiKey_None;
     } else if (_device == RE::INPUT_DEVICE::kGamepad) {
-        key = padMap[_scanCode];
+        auto index = GetPadIndex(_scanCode);
+        return index < table->pad.size() ? table->pad[index] : ImGuiKey_None;
     }
 
-    return key;
+    return ImGuiKey_None;
 }
 
 InputHandler::EventResult InputHandler::ProcessEvent(RE::InputEvent* const* _event,
@@ -162,12 +215,39 @@ InputHandler::EventResult InputHandler::ProcessEvent(RE::InputEvent* const* _eve
         } else if (event->eventType == RE::INPUT_EVENT_TYPE::kButton) {
             auto& io = ImGui::GetIO();
             const auto button = static_cast<RE::ButtonEvent*>(event);
-            if (!button || (button->IsPressed() && !button->IsDown())) continue;
+            if (!button) continue;
 
             auto device = button->device.get();
             auto scan_code = button->GetIDCode();
             auto imgui_key = GetImGuiKey(scan_code, device);
 
+            if (button->IsPressed() && !button->IsDown()) {
+                // Held repeats only matter to hold bindings: queue one per hold, once the threshold is reached, and
+                // only for keys the active layer binds a hold to.
+                if (device != RE::INPUT_DEVICE::kKeyboard && device != RE::INPUT_DEVICE::kGamepad) continue;
+                if (imgui_key < heldSent.size() && heldSent[imgui_key]) continue;
+
+                auto config = ConfigHandler::GetSingleton();
+                if (!config || button->HeldDuration() < config->Settings.holdTime) continue;
+                if (!EquipsetManager::GetSingleton()->IsHoldKey(imgui_key)) continue;
+
+                auto queue = InputQueue::GetSingleton();
+                if (!queue) continue;
+
+                auto recorder = InputRecorder::GetSingleton();
+                if (!recorder || recorder->IsReplaying()) continue;
+
+                InputQueue::Record record;
+                record.code = imgui_key;
+                record.modifier = InputQueue::GetModifierMask(isModifier1, isModifier2, isModifier3);
+                record.state = InputQueue::STATE::HELD;
+                record.heldDuration = button->HeldDuration();
+                record.timestamp = InputQueue::Now();
+                recorder->Capture(record);
+                if (queue->Push(record) && imgui_key < heldSent.size()) heldSent[imgui_key] = true;
+                continue;
+            }
+
             switch (button->device.get()) {
                 case RE::INPUT_DEVICE::kMouse:
                     if (scan_code > 7)  // middle scroll
@@ -190,10 +270,15 @@ InputHandler::EventResult InputHandler::ProcessEvent(RE::InputEvent* const* _eve
             auto config = ConfigHandler::GetSingleton();
             if (!config) return RE::BSEventNotifyControl::kContinue;
 
-            auto manager = EquipsetManager::GetSingleton();
-            if (!manager) return RE::BSEventNotifyControl::kContinue;
+            auto queue = InputQueue::GetSingleton();
+            if (!queue) return RE::BSEventNotifyControl::kContinue;
+
+            auto recorder = InputRecorder::GetSingleton();
+            if (!recorder) return RE::BSEventNotifyControl::kContinue;
 
             if (device == RE::INPUT_DEVICE::kKeyboard || device == RE::INPUT_DEVICE::kGamepad) {
+                if (imgui_key < heldSent.size()) heldSent[imgui_key] = false;
+
                 if (imgui_key == config->Settings.modifier1) {
                     isModifier1 = button->IsPressed();
                 } else if (imgui_key == config->Settings.modifier2) {
@@ -203,12 +288,31 @@ InputHandler::EventResult InputHandler::ProcessEvent(RE::InputEvent* const* _eve
                 }
             }
 
-            if ((device == RE::INPUT_DEVICE::kKeyboard || device == RE::INPUT_DEVICE::kGamepad) && !button->IsUp()) {
-                manager->ProcessEquip(imgui_key, isModifier1, isModifier2, isModifier3);
+            // The trigger itself is never part of its own required mask.
+            uint32_t padBit = 0U;
+            if (device == RE::INPUT_DEVICE::kGamepad) {
+                auto index = GetPadIndex(scan_code);
+                if (index < std::tuple_size_v<PadTable>) padBit = 1U << index;
+            }
+            auto padMask = padHeldMask & ~padBit & EquipsetManager::GetSingleton()->GetPadChordMask();
+            if (button->IsPressed()) {
+                padHeldMask |= padBit;
+            } else {
+                padHeldMask &= ~padBit;
             }
 
-            if ((device == RE::INPUT_DEVICE::kKeyboard || device == RE::INPUT_DEVICE::kGamepad) && !button->IsDown()) {
-                manager->CalculateKeydown(imgui_key, isModifier1, isModifier2, isModifier3, button->HeldDuration());
+            // Equip work is deferred to InputQueue::Drain, outside the input sink.
+            if (!recorder->IsReplaying() &&
+                (device == RE::INPUT_DEVICE::kKeyboard || device == RE::INPUT_DEVICE::kGamepad)) {
+                InputQueue::Record record;
+                record.code = imgui_key;
+                record.modifier = InputQueue::GetModifierMask(isModifier1, isModifier2, isModifier3);
+                record.padMask = padMask;
+                record.state = button->IsUp() ? InputQueue::STATE::RELEASE : InputQueue::STATE::PRESS;
+                record.heldDuration = button->HeldDuration();
+                record.timestamp = InputQueue::Now();
+                recorder->Capture(record);
+                queue->Push(record);
             }
         }
     }
@@ -1,21 +1,45 @@
 #pragma once
 
-#include <unordered_map>
-
 class InputHandler : public RE::BSTEventSink<RE::InputEvent*> {
+public:
+    using KeyTable = std::array<uint32_t, 256>;
+    using PadTable = std::array<uint32_t, 18>;
+
+    struct Keymap {
+        KeyTable key{};
+        PadTable pad{};
+    };
+
+    // XInput button masks are single bits, except the triggers which are reported as 9 and 10.
+    static constexpr uint32_t GetPadIndex(const uint32_t& _code) {
+        if (_code == 9) return 16;
+        if (_code == 10) return 17;
+        if (std::has_single_bit(_code) && _code <= 0x8000) return std::countr_zero(_code);
+
+        return std::tuple_size_v<PadTable>;
+    }
+
 private:
     using EventResult = RE::BSEventNotifyControl;
 
     bool isModifier1{false};
     bool isModifier2{false};
     bool isModifier3{false};
-    std::unordered_map<uint32_t, uint32_t> keyMap;
-    std::unordered_map<uint32_t, uint32_t> padMap;
+
+    // Bit: GetPadIndex of each gamepad button currently down
+    uint32_t padHeldMask{0U};
+    // Bit: ImGui key whose current hold was already queued
+    std::bitset<1024> heldSent;
+
+    std::array<Keymap, 2> keymapBuffer;
+    std::atomic<const Keymap*> keymap{nullptr};
 
     uint32_t GetImGuiKey(const uint32_t& _scanCode, RE::INPUT_DEVICE _device);
 
 public:
     static void Register();
+    void BuildKeymap();
+    uint32_t GetPadKey(const uint32_t& _index);
 
     virtual RE::BSEventNotifyControl ProcessEvent(RE::InputEvent* const* _event,
                                                   RE::BSTEventSource<RE::InputEvent*>* _eventSource) override;
@@ -63,6 +63,15 @@ namespace Extra {
         return result;
     }
 
+    RE::EnchantmentItem* GetEnchantment(const RE::ExtraDataList* _xList) {
+        if (!_xList || !(_xList->HasType(RE::ExtraDataType::kEnchantment))) {
+            return nullptr;
+        }
+
+        auto xEnch = _xList->GetByType<RE::ExtraEnchantment>();
+        return xEnch ? xEnch->enchantment : nullptr;
+    }
+
     float GetTempValue(const RE::ExtraDataList* _xList) {
         float result = 0.0f;
         if (!_xList) {
@@ -102,27 +111,71 @@ namespace Extra {
         return false;
     }
 
-    RE::ExtraDataList* SearchExtraDataList(const std::string& _name, const uint32_t& _enchNum,
-                                           const std::string& _enchName, const float& _tempVal) {
+    void ExtraDataIndex::Build(const std::vector<RE::TESForm*>& _forms) {
+        inventory.clear();
+        refreshed.clear();
+        isStale = false;
+
         auto player = RE::PlayerCharacter::GetSingleton();
-        if (!player) return nullptr;
+        if (!player) return;
+
+        std::unordered_set<RE::TESForm*> wanted(_forms.begin(), _forms.end());
+        inventory = player->GetInventory([&wanted](RE::TESBoundObject& _object) {
+            return _object.Is(RE::FormType::Weapon, RE::FormType::Armor) && wanted.contains(std::addressof(_object));
+        });
+    }
+
+    void ExtraDataIndex::Invalidate() {
+        refreshed.clear();
+        isStale = true;
+    }
+
+    void ExtraDataIndex::Refresh(RE::TESBoundObject* _object) {
+        inventory.erase(_object);
+        refreshed.insert(_object);
 
-        auto inv = player->GetInventory();
-        for (const auto& [item, data] : inv) {
-            const auto& [numItem, entry] = data;
-            if (!(numItem > 0 && item->Is(RE::FormType::Weapon, RE::FormType::Armor))) continue;
+        auto player = RE::PlayerCharacter::GetSingleton();
+        if (!player) return;
+
+        auto changed = player->GetInventory(
+            [_object](RE::TESBoundObject& _elem) { return std::addressof(_elem) == _object; });
+        for (auto& [item, data] : changed) {
+            inventory.insert_or_assign(item, std::move(data));
+        }
+    }
+
+    RE::ExtraDataList* ExtraDataIndex::Search(RE::TESForm* _form, const uint32_t& _enchNum,
+                                              const std::string& _enchName, const float& _tempVal) {
+        auto object = _form ? _form->As<RE::TESBoundObject>() : nullptr;
+        if (!object) return nullptr;
+
+        // The item and its count are checked against a fresh fetch before any cached list is handed out.
+        if (isStale && !refreshed.contains(object)) Refresh(object);
+
+        auto it = inventory.find(object);
+        if (it == inventory.end()) return nullptr;
+
+        const auto& [numItem, entry] = it->second;
+        if (numItem < 1 || !entry->extraLists) return nullptr;
+
+        // Same rules as GetEnchNum/GetEnchName: an enchantment on the list wins over the base one.
+        RE::EnchantmentItem* baseEnch = nullptr;
+        if (auto weapon = object->As<RE::TESObjectWEAP>(); weapon) {
+            baseEnch = weapon->formEnchanting;
+        } else if (auto armor = object->As<RE::TESObjectARMO>(); armor) {
+            baseEnch = armor->formEnchanting;
+        }
 
-            if (item->GetName() != _name) continue;
+        for (auto& xList : *entry->extraLists) {
+            if (GetTempValue(xList) != _tempVal) continue;
 
-            auto extraLists = entry->extraLists;
-            if (!extraLists) return nullptr;
+            auto enchantment = GetEnchantment(xList);
+            if (!enchantment) enchantment = baseEnch;
 
-            for (auto& xList : *extraLists) {
-                if (Extra::GetEnchNum(item, xList) == _enchNum &&
-                    Extra::GetEnchName(item, xList) == _enchName &&
-                    Extra::GetTempValue(xList) == _tempVal) {
-                    return xList;
-                }
+            uint32_t enchNum = enchantment ? static_cast<uint32_t>(enchantment->effects.size()) : 0U;
+            std::string_view enchName = enchantment ? enchantment->GetName() : ENCHNONE;
+            if (enchNum == _enchNum && enchName == _enchName) {
+                return xList;
             }
         }
 
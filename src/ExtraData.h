@@ -5,9 +5,28 @@ namespace Extra {
 
     uint32_t GetEnchNum(const RE::TESBoundObject* _obj, const RE::ExtraDataList* _xList);
     std::string GetEnchName(const RE::TESBoundObject* _obj, const RE::ExtraDataList* _xList);
+    RE::EnchantmentItem* GetEnchantment(const RE::ExtraDataList* _xList);
     float GetTempValue(const RE::ExtraDataList* _xList);
     bool IsFavorited(const RE::ExtraDataList* _xList);
     bool IsMagicFavorited(const RE::TESForm* _form);
 
-    RE::ExtraDataList* SearchExtraDataList(const std::string& _name, const uint32_t& _enchNum, const std::string& _enchName, const float& _tempVal);
+    // Extra data lists of the items one equip call touches, fetched in a single filtered inventory pass.
+    // Lookups go straight to the item and compare enchantments by pointer-held names, without copying strings.
+    class ExtraDataIndex {
+    public:
+        void Build(const std::vector<RE::TESForm*>& _forms);
+        // Call after every equip or unequip: the game may have split, merged or freed the cached lists, so each
+        // item is fetched again, on its own, the next time it is searched.
+        void Invalidate();
+        RE::ExtraDataList* Search(RE::TESForm* _form, const uint32_t& _enchNum, const std::string& _enchName,
+                                  const float& _tempVal);
+
+    private:
+        RE::TESObjectREFR::InventoryItemMap inventory;
+        // Items fetched again since the last Invalidate
+        std::unordered_set<RE::TESBoundObject*> refreshed;
+        bool isStale{false};
+
+        void Refresh(RE::TESBoundObject* _object);
+    };
 }
\ No newline at end of file
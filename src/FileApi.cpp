@@ -0,0 +1,92 @@
+#include "FileApi.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+    class NativeFile : public FileApi::File {
+    public:
+        explicit NativeFile(HANDLE _handle) : handle(_handle) {}
+        ~NativeFile() override { CloseHandle(handle); }
+
+        bool Write(const char* _data, size_t _size) override {
+            while (_size > 0) {
+                DWORD chunk = static_cast<DWORD>(std::min<size_t>(_size, 1U << 30));
+                DWORD written = 0;
+                if (!WriteFile(handle, _data, chunk, &written, nullptr) || written != chunk) return false;
+                _data += written;
+                _size -= written;
+            }
+            return true;
+        }
+
+        bool Sync() override { return FlushFileBuffers(handle); }
+
+    private:
+        HANDLE handle;
+    };
+
+    class NativeApi : public FileApi {
+    public:
+        std::unique_ptr<File> Create(const std::filesystem::path& _path) override {
+            auto handle =
+                CreateFileW(_path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE) return nullptr;
+            return std::make_unique<NativeFile>(handle);
+        }
+
+        bool Replace(const std::filesystem::path& _from, const std::filesystem::path& _to) override {
+            return MoveFileExW(_from.c_str(), _to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+        }
+
+        void Remove(const std::filesystem::path& _path) override { DeleteFileW(_path.c_str()); }
+    };
+#else
+    class NativeFile : public FileApi::File {
+    public:
+        explicit NativeFile(int _fd) : fd(_fd) {}
+        ~NativeFile() override { ::close(fd); }
+
+        bool Write(const char* _data, size_t _size) override {
+            while (_size > 0) {
+                auto written = ::write(fd, _data, _size);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                _data += written;
+                _size -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+
+        bool Sync() override { return ::fsync(fd) == 0; }
+
+    private:
+        int fd;
+    };
+
+    class NativeApi : public FileApi {
+    public:
+        std::unique_ptr<File> Create(const std::filesystem::path& _path) override {
+            auto fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) return nullptr;
+            return std::make_unique<NativeFile>(fd);
+        }
+
+        bool Replace(const std::filesystem::path& _from, const std::filesystem::path& _to) override {
+            return ::rename(_from.c_str(), _to.c_str()) == 0;
+        }
+
+        void Remove(const std::filesystem::path& _path) override { ::unlink(_path.c_str()); }
+    };
+#endif
+}
+
+FileApi* FileApi::GetNative() {
+    static NativeApi api;
+    return std::addressof(api);
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+// The file primitives FileWriter commits through. Tests swap in their own to check the temp-file and rename
+// sequence without touching the platform.
+class FileApi {
+public:
+    class File {
+    public:
+        // Closes the file.
+        virtual ~File() = default;
+
+        virtual bool Write(const char* _data, size_t _size) = 0;
+        // Forces everything written so far to disk.
+        virtual bool Sync() = 0;
+    };
+
+    virtual ~FileApi() = default;
+
+    // Creates _path for writing, replacing an existing file. Returns nullptr on failure.
+    virtual std::unique_ptr<File> Create(const std::filesystem::path& _path) = 0;
+    // Renames _from over _to in one step, so readers see either the old or the new file.
+    virtual bool Replace(const std::filesystem::path& _from, const std::filesystem::path& _to) = 0;
+    virtual void Remove(const std::filesystem::path& _path) = 0;
+
+    static FileApi* GetNative();
+};
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "FileWriter.h"
+
+namespace {
+    // Hands an encoder's output to the file in fixed chunks, so the contents are never held whole in memory.
+    class FileBuffer : public std::streambuf {
+    public:
+        explicit FileBuffer(FileApi::File& _file) : file(_file) { setp(buffer.data(), buffer.data() + buffer.size()); }
+
+    protected:
+        int_type overflow(int_type _ch) override {
+            if (sync() != 0) return traits_type::eof();
+            if (!traits_type::eq_int_type(_ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(_ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(_ch);
+        }
+
+        int sync() override {
+            auto size = static_cast<size_t>(pptr() - pbase());
+            if (size > 0 && !file.Write(pbase(), size)) return -1;
+            setp(buffer.data(), buffer.data() + buffer.size());
+            return 0;
+        }
+
+    private:
+        FileApi::File& file;
+        std::array<char, 64 * 1024> buffer;
+    };
+}
+
+void FileWriter::Write(const std::filesystem::path& _path, Encoder _encoder, Callback _done) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!isStarted) {
+            std::thread(&FileWriter::Run, this).detach();
+            isStarted = true;
+        }
+
+        auto key = _path.native();
+        auto [it, isNew] = pending.try_emplace(key);
+        it->second.path = _path;
+        it->second.encoder = std::move(_encoder);
+        if (_done) it->second.done.push_back(std::move(_done));
+        if (isNew) {
+            queue.push_back(std::move(key));
+        } else {
+            logger::info("Coalesced pending write of {}.", _path.filename().string());
+        }
+    }
+
+    wake.notify_one();
+}
+
+void FileWriter::Write(const std::filesystem::path& _path, std::string _contents, Callback _done) {
+    Write(_path, [contents = std::move(_contents)](std::ostream& _stream) { _stream << contents; }, std::move(_done));
+}
+
+void FileWriter::Flush() {
+    std::unique_lock<std::mutex> guard(lock);
+    idle.wait(guard, [this] { return queue.empty() && !isBusy; });
+}
+
+void FileWriter::Run() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this] { return !queue.empty(); });
+
+            auto it = pending.find(queue.front());
+            job = std::move(it->second);
+            pending.erase(it);
+            queue.pop_front();
+            isBusy = true;
+        }
+
+        // A throwing encoder or file primitive fails only its own job; the thread and the queue keep going.
+        bool isCommitted = false;
+        try {
+            isCommitted = Commit(job);
+        } catch (const std::exception& e) {
+            logger::error("Exception while writing {}: {}", job.path.filename().string(), e.what());
+            RemoveTemp(job.path);
+        } catch (...) {
+            logger::error("Unknown exception while writing {}.", job.path.filename().string());
+            RemoveTemp(job.path);
+        }
+        if (!isCommitted) {
+            logger::error("Failed to write {}!", job.path.filename().string());
+        }
+
+        for (auto& done : job.done) {
+            done(isCommitted);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            isBusy = false;
+        }
+        idle.notify_all();
+    }
+}
+
+std::filesystem::path FileWriter::GetTempPath(const std::filesystem::path& _path) {
+    auto temp = _path;
+    temp += ".tmp";
+    return temp;
+}
+
+void FileWriter::RemoveTemp(const std::filesystem::path& _path) {
+    try {
+        api->Remove(GetTempPath(_path));
+    } catch (...) {
+        logger::error("Unable to remove the temp file of {}.", _path.filename().string());
+    }
+}
+
+bool FileWriter::Commit(const Job& _job) {
+    auto temp = GetTempPath(_job.path);
+
+    auto file = api->Create(temp);
+    if (!file) return false;
+
+    bool isWritten;
+    {
+        FileBuffer buffer(*file);
+        std::ostream stream(&buffer);
+        _job.encoder(stream);
+        isWritten = stream.flush().good();
+    }
+
+    // The data has to be on disk before the rename, or a crash could publish an empty file.
+    isWritten = isWritten && file->Sync();
+    file.reset();
+
+    if (!isWritten || !api->Replace(temp, _job.path)) {
+        api->Remove(temp);
+        return false;
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "FileApi.h"
+
+// Persists files on a single background thread so the render thread never waits on disk.
+// Each write lands in a temp file that is flushed to disk and renamed over the target,
+// so a crash mid-write leaves the previous file intact.
+class FileWriter {
+public:
+    // Runs on the writer thread and streams straight into the file; encodes an already captured snapshot.
+    using Encoder = std::function<void(std::ostream&)>;
+    // Runs on the writer thread with whether the file landed, before Flush returns.
+    using Callback = std::function<void(bool)>;
+
+    // Queues a write of _path. A write to the same path still waiting in the queue is replaced, and its
+    // callback reports the outcome of the write that replaced it.
+    void Write(const std::filesystem::path& _path, Encoder _encoder, Callback _done = nullptr);
+    void Write(const std::filesystem::path& _path, std::string _contents, Callback _done = nullptr);
+    // Blocks until every queued write has been committed.
+    void Flush();
+    // Replaces the file primitives writes commit through; call while nothing is queued.
+    void SetFileApi(FileApi* _api) { api = _api; }
+
+private:
+    struct Job {
+        std::filesystem::path path;
+        Encoder encoder;
+        std::vector<Callback> done;
+    };
+
+    // Key: native path, in submission order; the latest job for each lives in pending.
+    std::deque<std::filesystem::path::string_type> queue;
+    std::unordered_map<std::filesystem::path::string_type, Job> pending;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    bool isBusy{false};
+    bool isStarted{false};
+    FileApi* api{FileApi::GetNative()};
+
+    void Run();
+    bool Commit(const Job& _job);
+    void RemoveTemp(const std::filesystem::path& _path);
+
+    static std::filesystem::path GetTempPath(const std::filesystem::path& _path);
+
+public:
+    static FileWriter* GetSingleton() {
+        static FileWriter singleton;
+        return std::addressof(singleton);
+    }
+
+private:
+    FileWriter() {}
+    FileWriter(const FileWriter&) = delete;
+    FileWriter(FileWriter&&) = delete;
+
+    ~FileWriter() = default;
+
+    FileWriter& operator=(const FileWriter&) = delete;
+    FileWriter& operator=(FileWriter&&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "FormResolver.h"
+
+void FormResolver::Defer(RE::TESForm** _target, RE::FormID _id, std::string_view _modname, bool _isDynamic) {
+    *_target = nullptr;
+    if (_id == 0) return;
+
+    if (_modname.empty()) {
+        if (_isDynamic) references.push_back(Reference{_target, _id, dynamicMod});
+        return;
+    }
+
+    references.push_back(Reference{_target, _id, GetModIndex(_modname)});
+}
+
+void FormResolver::Merge(FormResolver& _other) {
+    for (const auto& elem : _other.references) {
+        auto mod = elem.mod == dynamicMod ? dynamicMod : GetModIndex(_other.modnames[elem.mod]);
+        references.push_back(Reference{elem.target, elem.id, mod});
+    }
+
+    _other.references.clear();
+}
+
+uint32_t FormResolver::GetModIndex(std::string_view _modname) {
+    auto it = modMap.find(_modname);
+    if (it != modMap.end()) return it->second;
+
+    auto index = static_cast<uint32_t>(modnames.size());
+    it = modMap.emplace(std::string(_modname), index).first;
+    modnames.push_back(it->first);
+    return index;
+}
+
+void FormResolver::Resolve() {
+    auto TESDataHandler = RE::TESDataHandler::GetSingleton();
+    if (!TESDataHandler) return;
+
+    struct Mod {
+        bool isLoaded{false};
+        RE::FormID prefix{0};
+        RE::FormID mask{0};
+    };
+
+    // Same compile-index mapping as TESDataHandler::LookupForm, done once per plugin instead of per reference.
+    std::vector<Mod> mods(modnames.size());
+    std::vector<std::string_view> missingMods;
+    for (uint32_t i = 0; i < modnames.size(); i++) {
+        auto file = TESDataHandler->LookupModByName(modnames[i]);
+        if (!file || file->compileIndex == 0xFF) {
+            missingMods.push_back(modnames[i]);
+            continue;
+        }
+
+        auto& mod = mods[i];
+        mod.isLoaded = true;
+        if (file->IsLight()) {
+            mod.prefix = (0xFEU << 24) | (static_cast<RE::FormID>(file->smallFileCompileIndex) << 12);
+            mod.mask = 0xFFFU;
+        } else {
+            mod.prefix = static_cast<RE::FormID>(file->compileIndex) << 24;
+            mod.mask = 0xFFFFFFU;
+        }
+    }
+
+    // Key: resolved FormID
+    std::unordered_map<RE::FormID, RE::TESForm*> formMap;
+    uint32_t unresolved = 0U;
+    for (const auto& elem : references) {
+        RE::FormID id = elem.id;
+        if (elem.mod != dynamicMod) {
+            const auto& mod = mods[elem.mod];
+            if (!mod.isLoaded) {
+                unresolved++;
+                continue;
+            }
+            id = mod.prefix | (elem.id & mod.mask);
+        }
+
+        auto [it, inserted] = formMap.try_emplace(id, nullptr);
+        if (inserted) it->second = RE::TESForm::LookupByID(id);
+
+        *elem.target = it->second;
+        if (!it->second) unresolved++;
+    }
+
+    if (unresolved > 0) {
+        std::string missing;
+        for (const auto& elem : missingMods) {
+            if (!missing.empty()) missing += ", ";
+            missing += elem;
+        }
+
+        logger::warn("{} of {} form references could not be resolved ({} distinct forms). Missing plugins: {}",
+                     unresolved, references.size(), formMap.size(), missing.empty() ? "none" : missing);
+    }
+
+    references.clear();
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+// Collects (local FormID, plugin name) references while equipsets are unpacked and resolves them in one pass:
+// each plugin is looked up once, each distinct form once, and unresolved references are reported together.
+class FormResolver {
+public:
+    // _target must stay valid until Resolve; it is set to nullptr right away and filled in by Resolve.
+    void Defer(RE::TESForm** _target, RE::FormID _id, std::string_view _modname, bool _isDynamic);
+    void Resolve();
+    // Takes over _other's pending references, so per-thread resolvers can share one Resolve pass.
+    void Merge(FormResolver& _other);
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view _name) const { return std::hash<std::string_view>{}(_name); }
+    };
+
+    static constexpr uint32_t dynamicMod{UINT32_MAX};
+
+    struct Reference {
+        RE::TESForm** target;
+        RE::FormID id;
+        uint32_t mod;  // Index into modnames, or dynamicMod for a full runtime FormID
+    };
+
+    uint32_t GetModIndex(std::string_view _modname);
+
+    std::vector<Reference> references;
+    std::vector<std::string_view> modnames;
+    // Key: plugin name
+    // Value: index into modnames
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> modMap;
+};
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Data.h"
 #include "Draw.h"
 #include "GuiMenu.h"
+#include "Event/Input.h"
 
 #include <imgui.h>
 #include "extern/imgui_impl_dx11.h"
@@ -13,7 +14,8 @@
 #include "extern/IconsFontAwesome5.h"
 
 namespace Shared::Cycle {
-    void HotkeySection(uint32_t* _hotkey, bool* _modifier1, bool* _modifier2, bool* _modifier3) {
+    void HotkeySection(uint32_t* _hotkey, bool* _modifier1, bool* _modifier2, bool* _modifier3, uint32_t* _gesture,
+                       uint32_t* _leader, uint32_t* _layer, uint32_t* _padMask) {
         auto ts = Translator::GetSingleton();
         if (!ts) return;
 
@@ -28,6 +30,28 @@ namespace Shared::Cycle {
         ImGui::Checkbox(msg1.c_str(), _modifier1);
         ImGui::Checkbox(msg2.c_str(), _modifier2);
         ImGui::Checkbox(msg3.c_str(), _modifier3);
+
+        std::vector<std::string> items = {TRANSLATE("_GESTURE_PRESS"), TRANSLATE("_GESTURE_HOLD"),
+                                          TRANSLATE("_GESTURE_DOUBLETAP")};
+        Draw::Combo(items, _gesture, C_TRANSLATE("_EDIT_GESTURE"));
+        Draw::InputButton(_leader, "EquipsetLeader", TRANSLATE("_EDIT"), TRANSLATE("_EDIT_LEADERLABEL"));
+
+        if (*_layer < config->Settings.layers.size()) {
+            Draw::Combo(config->Settings.layers, _layer, C_TRANSLATE("_EDIT_LAYER"));
+        }
+
+        if (ImGui::TreeNode(C_TRANSLATE("_EDIT_PADCHORD"))) {
+            auto input = InputHandler::GetSingleton();
+            if (ImGui::BeginTable("PadChord", 3)) {
+                for (uint32_t i = 0; i < std::tuple_size_v<InputHandler::PadTable>; i++) {
+                    ImGui::TableNextColumn();
+                    auto label = fmt::format("{}##PadChord{}", ImGui::GetKeyName(input->GetPadKey(i)), i);
+                    ImGui::CheckboxFlags(label.c_str(), _padMask, 1U << i);
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TreePop();
+        }
     }
 
     void OptionSection(bool* _cyclePersist, float* _cycleExpire, float* _cycleReset) {
@@ -260,6 +284,10 @@ namespace Create::Cycle {
         static bool modifier1 = false;
         static bool modifier2 = false;
         static bool modifier3 = false;
+        static uint32_t gesture = 0U;
+        static uint32_t leader = 0U;
+        static uint32_t layer = manager->GetActiveLayer();
+        static uint32_t padMask = 0U;
         static bool cyclePersist = false;
         static float cycleExpire = 0.0f;
         static float cycleReset = 0.0f;
@@ -285,6 +313,10 @@ namespace Create::Cycle {
             modifier1 = false;
             modifier2 = false;
             modifier3 = false;
+            gesture = 0U;
+            leader = 0U;
+            layer = manager->GetActiveLayer();
+            padMask = 0U;
             cyclePersist = false;
             cycleExpire = 0.0f;
             cycleReset = 0.0f;
@@ -320,7 +352,7 @@ namespace Create::Cycle {
                 Draw::BeginGroupPanel(hotkeyLabel.c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0.0f),
                                       ImVec2(15.0f, 10.0f));
                 {
-                    Shared::Cycle::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3);
+                    Shared::Cycle::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3, &gesture, &leader, &layer, &padMask);
                 }
                 Draw::EndGroupPanel();
 
@@ -419,7 +451,8 @@ namespace Create::Cycle {
             auto buttonSize = ImGui::CalcTextSize((TRANSLATE("_OK") + TRANSLATE("_CANCEL")).c_str());
             if (ImGui::Button(C_TRANSLATE("_OK"), {-FLT_MIN, buttonSize.y + 15.0f})) {
                 auto [result_type, result_string] =
-                    manager->IsCreateValid(name, hotkey, modifier1, modifier2, modifier3);
+                    manager->IsCreateValid(name, hotkey, modifier1, modifier2, modifier3,
+                                           static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
 
                 if (result_type == EquipsetManager::VALID_TYPE::NAME_BLANK) {
                     ImGui::OpenPopup((title + "##NAME_BLANK").c_str());
@@ -439,6 +472,10 @@ namespace Create::Cycle {
                     cycleset.modifier1 = modifier1;
                     cycleset.modifier2 = modifier2;
                     cycleset.modifier3 = modifier3;
+                    cycleset.gesture = static_cast<Equipset::GESTURE>(gesture);
+                    cycleset.leader = leader;
+                    cycleset.layer = layer;
+                    cycleset.padMask = padMask;
                     cycleset.cyclePersist = cyclePersist;
                     cycleset.cycleExpire = cycleExpire;
                     cycleset.cycleReset = cycleReset;
@@ -458,7 +495,7 @@ namespace Create::Cycle {
                     auto manager = EquipsetManager::GetSingleton();
                     if (!manager) logger::error("Failed to get EquipsetManager!");
 
-                    manager->Create(cycleset, true);
+                    manager->Create(std::move(cycleset), true);
 
                     close_popup = true;
                 }
@@ -552,6 +589,10 @@ namespace Show::Cycle {
         static bool modifier1 = cycleset->modifier1;
         static bool modifier2 = cycleset->modifier2;
         static bool modifier3 = cycleset->modifier3;
+        static uint32_t gesture = static_cast<uint32_t>(cycleset->gesture);
+        static uint32_t leader = cycleset->leader;
+        static uint32_t layer = cycleset->layer;
+        static uint32_t padMask = cycleset->padMask;
         static bool cyclePersist = cycleset->cyclePersist;
         static float cycleExpire = cycleset->cycleExpire;
         static float cycleReset = cycleset->cycleReset;
@@ -577,6 +618,10 @@ namespace Show::Cycle {
             modifier1 = cycleset->modifier1;
             modifier2 = cycleset->modifier2;
             modifier3 = cycleset->modifier3;
+            gesture = static_cast<uint32_t>(cycleset->gesture);
+            leader = cycleset->leader;
+            layer = cycleset->layer;
+            padMask = cycleset->padMask;
             cyclePersist = cycleset->cyclePersist;
             cycleExpire = cycleset->cycleExpire;
             cycleReset = cycleset->cycleReset;
@@ -604,6 +649,10 @@ namespace Show::Cycle {
             modifier1 != cycleset->modifier1 ||
             modifier2 != cycleset->modifier2 ||
             modifier3 != cycleset->modifier3 ||
+            gesture != static_cast<uint32_t>(cycleset->gesture) ||
+            leader != cycleset->leader ||
+            layer != cycleset->layer ||
+            padMask != cycleset->padMask ||
             cyclePersist != cycleset->cyclePersist ||
             cycleExpire != cycleset->cycleExpire ||
             cycleReset != cycleset->cycleReset ||
@@ -675,7 +724,8 @@ namespace Show::Cycle {
         if (ImGui::Button(C_TRANSLATE("_SAVECHANGES"),
                           ImVec2(ImGui::CalcTextSize(C_TRANSLATE("_SAVECHANGES")).x + 30.0f, 0))) {
             auto [result_type, result_string] =
-                manager->IsEditValid(cycleset, name, hotkey, modifier1, modifier2, modifier3);
+                manager->IsEditValid(cycleset, name, hotkey, modifier1, modifier2, modifier3,
+                                     static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
 
             if (result_type == EquipsetManager::VALID_TYPE::NAME_BLANK) {
                 ImGui::OpenPopup((title + "##NAME_BLANK").c_str());
@@ -688,11 +738,9 @@ namespace Show::Cycle {
                 ImGui::OpenPopup((title + "##HOTKEY_CONFLICT").c_str());
 
             } else if (result_type == EquipsetManager::VALID_TYPE::GOOD) {
-                cycleset->name = name;
-                cycleset->hotkey = hotkey;
-                cycleset->modifier1 = modifier1;
-                cycleset->modifier2 = modifier2;
-                cycleset->modifier3 = modifier3;
+                manager->Rename(cycleset, name);
+                manager->SetChord(cycleset, hotkey, modifier1, modifier2, modifier3,
+                                  static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
                 cycleset->cyclePersist = cyclePersist;
                 cycleset->cycleExpire = cycleExpire;
                 cycleset->cycleReset = cycleReset;
@@ -709,6 +757,8 @@ namespace Show::Cycle {
                 cycleset->widgetHotkey.offsetY = hotkey_offsetY;
                 cycleset->items = equipset;
                 cycleset->cycleIndex = 0U;
+                cycleset->DiscardPayload();
+                cycleset->MarkDirty();
                 cycleset->CloseExpireTimer();
                 cycleset->CloseResetTimer();
 
@@ -733,7 +783,7 @@ namespace Show::Cycle {
                 Draw::BeginGroupPanel(hotkeyLabel.c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0.0f),
                                       ImVec2(15.0f, 10.0f));
                 {
-                    Shared::Cycle::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3);
+                    Shared::Cycle::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3, &gesture, &leader, &layer, &padMask);
                 }
                 Draw::EndGroupPanel();
 
@@ -6,6 +6,9 @@
 #include "Equipment.h"
 #include "Translate.h"
 #include "WidgetHandler.h"
+#include "HUDHandler.h"
+#include "InputRecorder.h"
+#include "Event/Input.h"
 
 #include <filesystem>
 
@@ -44,6 +47,10 @@ void GuiMenu::Toggle(std::optional<bool> enabled = std::nullopt) {
     show = enabled.value_or(!show);
     DisableInput(show);
     if (show) {
+        // The editor reads every field, so pending payloads are decoded up front.
+        auto manager = EquipsetManager::GetSingleton();
+        if (manager) manager->MaterializeAll();
+
         dataHandler->Init();
         widgetHandler->CloseExpireTimer();
         widgetHandler->SetMenuAlpha(100);
@@ -140,11 +147,7 @@ void GuiMenu::DrawMain() {
                     manager->ExportEquipsets();
                 }
                 if (ImGui::MenuItem(C_TRANSLATE("_MENUBAR_LOAD"))) {
-                    manager->RemoveAllWidget();
-                    manager->RemoveAll();
                     manager->ImportEquipsets();
-                    manager->SyncSortOrder();
-                    manager->CreateAllWidget();
                 }
                 ImGui::MenuItem("##BLANK", NULL, false, false);
                 ImGui::MenuItem(C_TRANSLATE("_TAB_EQUIPMENT"), NULL, false, false);
@@ -169,13 +172,34 @@ void GuiMenu::DrawMain() {
                 }
                 if (ImGui::MenuItem(C_TRANSLATE("_MENUBAR_LOAD"))) {
                     config->LoadConfig();
+                    HUDHandler::GetSingleton()->SyncBlockMenu();
+                    InputHandler::GetSingleton()->BuildKeymap();
                     ts->Load();
                     dataHandler->Init();
                     GuiMenu::NotifyFontReload();
                 }
+                ImGui::MenuItem("##BLANK", NULL, false, false);
+                ImGui::MenuItem(C_TRANSLATE("_MENUBAR_INPUT"), NULL, false, false);
+                ImGui::Separator();
+                auto recorder = InputRecorder::GetSingleton();
+                if (recorder->IsRecording()) {
+                    if (ImGui::MenuItem(C_TRANSLATE("_MENUBAR_RECORD_STOP"))) {
+                        recorder->Stop();
+                    }
+                } else if (ImGui::MenuItem(C_TRANSLATE("_MENUBAR_RECORD"), NULL, false, !recorder->IsReplaying())) {
+                    recorder->Start();
+                }
+                if (ImGui::MenuItem(C_TRANSLATE("_MENUBAR_REPLAY"), NULL, false,
+                                    !recorder->IsRecording() && !recorder->IsReplaying())) {
+                    recorder->Replay();
+                }
                 
                 ImGui::EndMenu();
             }
+            // Item lists show their previous contents until the rebuild lands.
+            if (dataHandler->IsLoading()) {
+                ImGui::TextDisabled(ICON_FA_HOURGLASS_HALF);
+            }
             ImGui::EndMenuBar();
         }
 
@@ -785,6 +809,14 @@ void GuiMenu::DrawConfig() {
                 Draw::InputButton(&config->Settings.modifier1, "Modifier1", TRANSLATE("_EDIT"), TRANSLATE("_MODIFIER1"));
                 Draw::InputButton(&config->Settings.modifier2, "Modifier2", TRANSLATE("_EDIT"), TRANSLATE("_MODIFIER2"));
                 Draw::InputButton(&config->Settings.modifier3, "Modifier3", TRANSLATE("_EDIT"), TRANSLATE("_MODIFIER3"));
+                Draw::InputButton(&config->Settings.layerHotkey, "LayerHotkey", TRANSLATE("_EDIT"),
+                                  TRANSLATE("_TAB_CONFIG_SETTINGS_LAYERHOTKEY"));
+                Draw::SliderFloat(C_TRANSLATE("_TAB_CONFIG_SETTINGS_HOLDTIME"), &config->Settings.holdTime, 0.1f, 2.0f,
+                                  "%.2f", ImGuiSliderFlags_AlwaysClamp);
+                Draw::SliderFloat(C_TRANSLATE("_TAB_CONFIG_SETTINGS_DOUBLETAPTIME"), &config->Settings.doubleTapTime,
+                                  0.1f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+                Draw::SliderFloat(C_TRANSLATE("_TAB_CONFIG_SETTINGS_LEADERTIMEOUT"), &config->Settings.leaderTimeout,
+                                  0.2f, 3.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
             }
             ImGui::EndGroup();
             auto size = ImGui::GetItemRectSize();
@@ -802,6 +834,12 @@ void GuiMenu::DrawConfig() {
                                                   TRANSLATE("_TAB_CONFIG_SETTINGS_SORT_NAMEDESC")};
                 Draw::Combo(items, &config->Settings.sort, C_TRANSLATE("_TAB_CONFIG_SETTINGS_SORTORDER"));
                 ImGui::Checkbox(C_TRANSLATE("_TAB_CONFIG_SETTINGS_FAVOR"), &config->Settings.favorOnly);
+                auto manager = EquipsetManager::GetSingleton();
+                uint32_t activeLayer = manager->GetActiveLayer();
+                if (activeLayer < config->Settings.layers.size() &&
+                    Draw::Combo(config->Settings.layers, &activeLayer, C_TRANSLATE("_TAB_CONFIG_SETTINGS_LAYER"))) {
+                    manager->SetActiveLayer(activeLayer);
+                }
             }
             ImGui::EndGroup();
         }
@@ -6,6 +6,7 @@
 #include "Data.h"
 #include "Draw.h"
 #include "GuiMenu.h"
+#include "Event/Input.h"
 #include "ExtraData.h"
 
 #include <imgui.h>
@@ -20,39 +21,42 @@ static void DrawComboWeapon(DataWeapon* _weapon, const std::string& _label, bool
     auto dataHandler = DataHandler::GetSingleton();
     if (!dataHandler) return;
 
-    std::vector<DataWeapon> weapon;
-    if (_isLeft) weapon = dataHandler->weapon_left;
-    else weapon = dataHandler->weapon_right;
+    auto lists = dataHandler->Get();
+    const auto& catalog = lists->catalog;
+    const auto& weapon = _isLeft ? lists->weapon_left : lists->weapon_right;
 
     if (ImGui::BeginCombo(_label.c_str(), _weapon->name.c_str())) {
         for (int i = 0; i < weapon.size(); i++) {
-            const auto& data = weapon[i];
-            bool is_selected = (_weapon->type == data.type) && (_weapon->name == data.name) &&
-                               (_weapon->enchNum == data.enchNum) && (_weapon->enchName == data.enchName) &&
-                               (_weapon->tempVal == data.tempVal);
+            auto row = weapon[i];
+            auto type = catalog.type[row];
+            const auto& name = catalog.GetName(row);
+            const auto& enchName = catalog.GetEnchName(row);
+            bool is_selected = (_weapon->type == type) && (_weapon->name == name) &&
+                               (_weapon->enchNum == catalog.enchNum[row]) && (_weapon->enchName == enchName) &&
+                               (_weapon->tempVal == catalog.tempVal[row]);
             ImGui::PushID(i);
 
-            if (ImGui::Selectable(data.name.c_str(), is_selected)) {
-                *_weapon = data;
+            if (ImGui::Selectable(name.c_str(), is_selected)) {
+                *_weapon = catalog.GetWeapon(row);
             }
             if (is_selected) {
                 ImGui::SetItemDefaultFocus();
             }
             if (ImGui::IsItemHovered()) {
                 std::string msg = "";
-                if (data.type == Data::DATATYPE::WEAP) {
-                    auto enchName = data.enchName == Extra::ENCHNONE ? TRANSLATE("_NOTHING") : data.enchName;
+                if (type == Data::DATATYPE::WEAP) {
+                    auto enchLabel = enchName == Extra::ENCHNONE ? TRANSLATE("_NOTHING") : enchName;
                     msg = TRANSLATE("_TOOLTIP_TYPE") +
                           TRANSLATE("_TOOLTIP_TYPE_WEAPON") + "\n" +
-                          TRANSLATE("_TOOLTIP_NAME") + data.name + "\n" +
-                          TRANSLATE("_TOOLTIP_ENCHNUM") + fmt::format("{}\n", data.enchNum) +
-                          TRANSLATE("_TOOLTIP_ENCHNAME") + enchName + "\n" +
-                          TRANSLATE("_TOOLTIP_TEMPVAL") + fmt::format("{}", data.tempVal);
+                          TRANSLATE("_TOOLTIP_NAME") + name + "\n" +
+                          TRANSLATE("_TOOLTIP_ENCHNUM") + fmt::format("{}\n", catalog.enchNum[row]) +
+                          TRANSLATE("_TOOLTIP_ENCHNAME") + enchLabel + "\n" +
+                          TRANSLATE("_TOOLTIP_TEMPVAL") + fmt::format("{}", catalog.tempVal[row]);
                     ImGui::SetTooltip(msg.c_str());
-                } else if (data.type == Data::DATATYPE::SPELL) {
+                } else if (type == Data::DATATYPE::SPELL) {
                     msg = TRANSLATE("_TOOLTIP_TYPE") +
                           TRANSLATE("_TOOLTIP_TYPE_SPELL") + "\n" +
-                          TRANSLATE("_TOOLTIP_NAME") + data.name;
+                          TRANSLATE("_TOOLTIP_NAME") + name;
                     ImGui::SetTooltip(msg.c_str());
                 }
             }
@@ -63,7 +67,8 @@ static void DrawComboWeapon(DataWeapon* _weapon, const std::string& _label, bool
 }
 
 namespace Shared::Normal {
-    void HotkeySection(uint32_t* _hotkey, bool* _modifier1, bool* _modifier2, bool* _modifier3) {
+    void HotkeySection(uint32_t* _hotkey, bool* _modifier1, bool* _modifier2, bool* _modifier3, uint32_t* _gesture,
+                       uint32_t* _leader, uint32_t* _layer, uint32_t* _padMask) {
         auto ts = Translator::GetSingleton();
         if (!ts) return;
 
@@ -78,6 +83,28 @@ namespace Shared::Normal {
         ImGui::Checkbox(msg1.c_str(), _modifier1);
         ImGui::Checkbox(msg2.c_str(), _modifier2);
         ImGui::Checkbox(msg3.c_str(), _modifier3);
+
+        std::vector<std::string> items = {TRANSLATE("_GESTURE_PRESS"), TRANSLATE("_GESTURE_HOLD"),
+                                          TRANSLATE("_GESTURE_DOUBLETAP")};
+        Draw::Combo(items, _gesture, C_TRANSLATE("_EDIT_GESTURE"));
+        Draw::InputButton(_leader, "EquipsetLeader", TRANSLATE("_EDIT"), TRANSLATE("_EDIT_LEADERLABEL"));
+
+        if (*_layer < config->Settings.layers.size()) {
+            Draw::Combo(config->Settings.layers, _layer, C_TRANSLATE("_EDIT_LAYER"));
+        }
+
+        if (ImGui::TreeNode(C_TRANSLATE("_EDIT_PADCHORD"))) {
+            auto input = InputHandler::GetSingleton();
+            if (ImGui::BeginTable("PadChord", 3)) {
+                for (uint32_t i = 0; i < std::tuple_size_v<InputHandler::PadTable>; i++) {
+                    ImGui::TableNextColumn();
+                    auto label = fmt::format("{}##PadChord{}", ImGui::GetKeyName(input->GetPadKey(i)), i);
+                    ImGui::CheckboxFlags(label.c_str(), _padMask, 1U << i);
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TreePop();
+        }
     }
 
     void OptionSection(bool* equipSound, bool* toggleEquip, bool* reEquip) {
@@ -151,17 +178,16 @@ namespace Shared::Normal {
         DrawComboWeapon(_lefthand, TRANSLATE("_WEAPON_LEFTHAND"), true);
         DrawComboWeapon(_righthand, TRANSLATE("_WEAPON_RIGHTHAND"), false);
 
-        std::vector<std::string> items;
-        for (const auto& item : dataHandler->shout) {
-            items.push_back(item.name);
-        }
-
+        auto lists = dataHandler->Get();
+        const auto& catalog = lists->catalog;
         if (ImGui::BeginCombo(C_TRANSLATE("_SHOUT"), _shout->name.c_str())) {
-            for (int i = 0; i < items.size(); i++) {
-                bool is_selected = (_shout->name == items[i]);
+            for (int i = 0; i < lists->shout.size(); i++) {
+                auto row = lists->shout[i];
+                const auto& name = catalog.GetName(row);
+                bool is_selected = (_shout->name == name);
                 ImGui::PushID(i);
-                if (ImGui::Selectable(items[i].c_str(), is_selected)) {
-                    *_shout = dataHandler->shout[i];
+                if (ImGui::Selectable(name.c_str(), is_selected)) {
+                    *_shout = catalog.GetShout(row);
                 }
                 if (is_selected) {
                     ImGui::SetItemDefaultFocus();
@@ -179,10 +205,13 @@ namespace Shared::Normal {
         auto dataHandler = DataHandler::GetSingleton();
         if (!dataHandler) return;
 
+        // Held for the whole frame, so a rebuild published meanwhile cannot pull the list out from under the popup.
+        auto lists = dataHandler->Get();
+
         if (ImGui::BeginTable("Item_Table", 2)) {
             ImGui::TableNextColumn();
             if (ImGui::Button(C_TRANSLATE("_ADD"), {ImGui::GetContentRegionAvail().x - 7.5f, 0.f})) {
-                if (dataHandler->armor.size() != 0) {
+                if (lists->armor.size() != 0) {
                     ImGui::OpenPopup(C_TRANSLATE("_ITEM_ADDPOPUP"));
                 }
             }
@@ -190,15 +219,11 @@ namespace Shared::Normal {
             ImVec2 center = ImGui::GetMainViewport()->GetCenter();
             ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
             if (ImGui::BeginPopupModal(C_TRANSLATE("_ITEM_ADDPOPUP"), NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
-                std::vector<std::string> items;
-                for (int i = 0; i < dataHandler->armor.size(); i++) {
-                    items.push_back(dataHandler->armor[i].name);
-                }
-
+                const auto& catalog = lists->catalog;
                 if (ImGui::BeginListBox("##listbox1")) {
-                    for (int i = 0; i < dataHandler->armor.size(); i++) {
+                    for (int i = 0; i < lists->armor.size(); i++) {
                         const bool is_selected = (*_popup_armorIndex == i);
-                        if (ImGui::Selectable(items[i].c_str(), is_selected)) {
+                        if (ImGui::Selectable(catalog.GetName(lists->armor[i]).c_str(), is_selected)) {
                             *_popup_armorIndex = i;
                         }
 
@@ -214,7 +239,9 @@ namespace Shared::Normal {
                     auto buttonSize = ImGui::CalcTextSize((TRANSLATE("_OK") + TRANSLATE("_CANCEL")).c_str());
                     if (ImGui::Button(C_TRANSLATE("_OK"),
                                       ImVec2(ImGui::GetWindowContentRegionMax().x * 0.45f, buttonSize.y + 15.0f))) {
-                        _armor->push_back(dataHandler->armor[*_popup_armorIndex]);
+                        if (*_popup_armorIndex < lists->armor.size()) {
+                            _armor->push_back(catalog.GetArmor(lists->armor[*_popup_armorIndex]));
+                        }
                         ImGui::CloseCurrentPopup();
                     }
 
@@ -330,6 +357,10 @@ namespace Create::Normal {
         static bool modifier1 = false;
         static bool modifier2 = false;
         static bool modifier3 = false;
+        static uint32_t gesture = 0U;
+        static uint32_t leader = 0U;
+        static uint32_t layer = manager->GetActiveLayer();
+        static uint32_t padMask = 0U;
         static bool equipSound = true;
         static bool toggleEquip = false;
         static bool reEquip = false;
@@ -359,6 +390,10 @@ namespace Create::Normal {
             modifier1 = false;
             modifier2 = false;
             modifier3 = false;
+            gesture = 0U;
+            leader = 0U;
+            layer = manager->GetActiveLayer();
+            padMask = 0U;
             equipSound = true;
             toggleEquip = false;
             reEquip = false;
@@ -398,7 +433,7 @@ namespace Create::Normal {
                 Draw::BeginGroupPanel(hotkeyLabel.c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0.0f),
                                       ImVec2(15.0f, 10.0f));
                 {
-                    Shared::Normal::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3);
+                    Shared::Normal::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3, &gesture, &leader, &layer, &padMask);
                 }
                 Draw::EndGroupPanel();
                 
@@ -498,7 +533,8 @@ namespace Create::Normal {
             auto buttonSize = ImGui::CalcTextSize((TRANSLATE("_OK") + TRANSLATE("_CANCEL")).c_str());
             if (ImGui::Button(C_TRANSLATE("_OK"), {-FLT_MIN, buttonSize.y + 15.0f})) {
                 auto [result_type, result_string] =
-                    manager->IsCreateValid(name, hotkey, modifier1, modifier2, modifier3);
+                    manager->IsCreateValid(name, hotkey, modifier1, modifier2, modifier3,
+                                           static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
 
                 if (result_type == EquipsetManager::VALID_TYPE::NAME_BLANK) {
                     ImGui::OpenPopup((title + "##NAME_BLANK").c_str());
@@ -518,6 +554,10 @@ namespace Create::Normal {
                     equipset.modifier1 = modifier1;
                     equipset.modifier2 = modifier2;
                     equipset.modifier3 = modifier3;
+                    equipset.gesture = static_cast<Equipset::GESTURE>(gesture);
+                    equipset.leader = leader;
+                    equipset.layer = layer;
+                    equipset.padMask = padMask;
                     equipset.equipSound = equipSound;
                     equipset.toggleEquip = toggleEquip;
                     equipset.reEquip = reEquip;
@@ -541,7 +581,7 @@ namespace Create::Normal {
                     auto manager = EquipsetManager::GetSingleton();
                     if (!manager) logger::error("Failed to get EquipsetManager!");
 
-                    manager->Create(equipset, true);
+                    manager->Create(std::move(equipset), true);
 
                     close_popup = true;
                 }
@@ -635,6 +675,10 @@ namespace Show::Normal {
         static bool modifier1 = equipset->modifier1;
         static bool modifier2 = equipset->modifier2;
         static bool modifier3 = equipset->modifier3;
+        static uint32_t gesture = static_cast<uint32_t>(equipset->gesture);
+        static uint32_t leader = equipset->leader;
+        static uint32_t layer = equipset->layer;
+        static uint32_t padMask = equipset->padMask;
         static bool equipSound = equipset->equipSound;
         static bool toggleEquip = equipset->toggleEquip;
         static bool reEquip = equipset->reEquip;
@@ -664,6 +708,10 @@ namespace Show::Normal {
             modifier1 = equipset->modifier1;
             modifier2 = equipset->modifier2;
             modifier3 = equipset->modifier3;
+            gesture = static_cast<uint32_t>(equipset->gesture);
+            leader = equipset->leader;
+            layer = equipset->layer;
+            padMask = equipset->padMask;
             equipSound = equipset->equipSound;
             toggleEquip = equipset->toggleEquip;
             reEquip = equipset->reEquip;
@@ -695,6 +743,10 @@ namespace Show::Normal {
             modifier1 != equipset->modifier1 ||
             modifier2 != equipset->modifier2 ||
             modifier3 != equipset->modifier3 ||
+            gesture != static_cast<uint32_t>(equipset->gesture) ||
+            leader != equipset->leader ||
+            layer != equipset->layer ||
+            padMask != equipset->padMask ||
             equipSound != equipset->equipSound ||
             toggleEquip != equipset->toggleEquip ||
             reEquip != equipset->reEquip ||
@@ -770,7 +822,8 @@ namespace Show::Normal {
         if (ImGui::Button(C_TRANSLATE("_SAVECHANGES"),
                           ImVec2(ImGui::CalcTextSize(C_TRANSLATE("_SAVECHANGES")).x + 30.0f, 0))) {
             auto [result_type, result_string] =
-                manager->IsEditValid(equipset, name, hotkey, modifier1, modifier2, modifier3);
+                manager->IsEditValid(equipset, name, hotkey, modifier1, modifier2, modifier3,
+                                     static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
 
             if (result_type == EquipsetManager::VALID_TYPE::NAME_BLANK) {
                 ImGui::OpenPopup((title + "##NAME_BLANK").c_str());
@@ -785,11 +838,9 @@ namespace Show::Normal {
             } else if (result_type == EquipsetManager::VALID_TYPE::GOOD) {
                 std::string prevName = equipset->name;
 
-                equipset->name = name;
-                equipset->hotkey = hotkey;
-                equipset->modifier1 = modifier1;
-                equipset->modifier2 = modifier2;
-                equipset->modifier3 = modifier3;
+                manager->Rename(equipset, name);
+                manager->SetChord(equipset, hotkey, modifier1, modifier2, modifier3,
+                                  static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
                 equipset->equipSound = equipSound;
                 equipset->toggleEquip = toggleEquip;
                 equipset->reEquip = reEquip;
@@ -809,6 +860,8 @@ namespace Show::Normal {
                 equipset->righthand = righthand;
                 equipset->shout = shout;
                 equipset->items = armor;
+                equipset->DiscardPayload();
+                equipset->MarkDirty();
 
                 equipset->SyncEquipset(prevName, equipset->name);
 
@@ -834,7 +887,7 @@ namespace Show::Normal {
                 Draw::BeginGroupPanel(hotkeyLabel.c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0.0f),
                                       ImVec2(15.0f, 10.0f));
                 {
-                    Shared::Normal::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3);
+                    Shared::Normal::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3, &gesture, &leader, &layer, &padMask);
                 }
                 Draw::EndGroupPanel();
 
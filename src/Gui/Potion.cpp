@@ -6,27 +6,24 @@
 #include "Data.h"
 #include "Draw.h"
 #include "GuiMenu.h"
+#include "Event/Input.h"
 
 #include <imgui.h>
 #include "extern/imgui_impl_dx11.h"
 #include "extern/imgui_stdlib.h"
 #include "extern/IconsFontAwesome5.h"
 
-static void DrawComboPotion(DataPotion* _potion, const std::vector<DataPotion>& _potionVec, const std::string& _label) {
-    auto ts = Translator::GetSingleton();
-    if (!ts) return;
-
-    auto dataHandler = DataHandler::GetSingleton();
-    if (!dataHandler) return;
-
+static void DrawComboPotion(DataPotion* _potion, const ItemCatalog& _catalog,
+                            const std::vector<ItemCatalog::Row>& _potionVec, const std::string& _label) {
     if (ImGui::BeginCombo(_label.c_str(), _potion->name.c_str())) {
         for (int i = 0; i < _potionVec.size(); i++) {
-            const auto& data = _potionVec[i];
-            bool is_selected = (_potion->type == data.type) && (_potion->name == data.name);
+            auto row = _potionVec[i];
+            const auto& name = _catalog.GetName(row);
+            bool is_selected = (_potion->type == _catalog.type[row]) && (_potion->name == name);
             ImGui::PushID(i);
 
-            if (ImGui::Selectable(data.name.c_str(), is_selected)) {
-                *_potion = data;
+            if (ImGui::Selectable(name.c_str(), is_selected)) {
+                *_potion = _catalog.GetPotion(row);
             }
             if (is_selected) {
                 ImGui::SetItemDefaultFocus();
@@ -38,7 +35,8 @@ static void DrawComboPotion(DataPotion* _potion, const std::vector<DataPotion>&
 }
 
 namespace Shared::Potion {
-    void HotkeySection(uint32_t* _hotkey, bool* _modifier1, bool* _modifier2, bool* _modifier3) {
+    void HotkeySection(uint32_t* _hotkey, bool* _modifier1, bool* _modifier2, bool* _modifier3, uint32_t* _gesture,
+                       uint32_t* _leader, uint32_t* _layer, uint32_t* _padMask) {
         auto ts = Translator::GetSingleton();
         if (!ts) return;
 
@@ -53,6 +51,28 @@ namespace Shared::Potion {
         ImGui::Checkbox(msg1.c_str(), _modifier1);
         ImGui::Checkbox(msg2.c_str(), _modifier2);
         ImGui::Checkbox(msg3.c_str(), _modifier3);
+
+        std::vector<std::string> items = {TRANSLATE("_GESTURE_PRESS"), TRANSLATE("_GESTURE_HOLD"),
+                                          TRANSLATE("_GESTURE_DOUBLETAP")};
+        Draw::Combo(items, _gesture, C_TRANSLATE("_EDIT_GESTURE"));
+        Draw::InputButton(_leader, "EquipsetLeader", TRANSLATE("_EDIT"), TRANSLATE("_EDIT_LEADERLABEL"));
+
+        if (*_layer < config->Settings.layers.size()) {
+            Draw::Combo(config->Settings.layers, _layer, C_TRANSLATE("_EDIT_LAYER"));
+        }
+
+        if (ImGui::TreeNode(C_TRANSLATE("_EDIT_PADCHORD"))) {
+            auto input = InputHandler::GetSingleton();
+            if (ImGui::BeginTable("PadChord", 3)) {
+                for (uint32_t i = 0; i < std::tuple_size_v<InputHandler::PadTable>; i++) {
+                    ImGui::TableNextColumn();
+                    auto label = fmt::format("{}##PadChord{}", ImGui::GetKeyName(input->GetPadKey(i)), i);
+                    ImGui::CheckboxFlags(label.c_str(), _padMask, 1U << i);
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TreePop();
+        }
     }
 
     void OptionSection(bool* _equipSound, bool* _calcDuration) {
@@ -121,9 +141,10 @@ namespace Shared::Potion {
         auto dataHandler = DataHandler::GetSingleton();
         if (!dataHandler) return;
 
-        DrawComboPotion(_health, dataHandler->potion_health, TRANSLATE("_HEALTH_POTION"));
-        DrawComboPotion(_magicka, dataHandler->potion_magicka, TRANSLATE("_MAGICKA_POTION"));
-        DrawComboPotion(_stamina, dataHandler->potion_stamina, TRANSLATE("_STAMINA_POTION"));
+        auto lists = dataHandler->Get();
+        DrawComboPotion(_health, lists->catalog, lists->potion_health, TRANSLATE("_HEALTH_POTION"));
+        DrawComboPotion(_magicka, lists->catalog, lists->potion_magicka, TRANSLATE("_MAGICKA_POTION"));
+        DrawComboPotion(_stamina, lists->catalog, lists->potion_stamina, TRANSLATE("_STAMINA_POTION"));
     }
 
     void PotionItemSection(std::vector<DataPotion>* _potion, uint32_t* _page_potionIndex, uint32_t* _popup_potionIndex) {
@@ -133,10 +154,13 @@ namespace Shared::Potion {
         auto dataHandler = DataHandler::GetSingleton();
         if (!dataHandler) return;
 
+        // Held for the whole frame, so a rebuild published meanwhile cannot pull the list out from under the popup.
+        auto lists = dataHandler->Get();
+
         if (ImGui::BeginTable("Item_Table", 2)) {
             ImGui::TableNextColumn();
             if (ImGui::Button(C_TRANSLATE("_ADD"), {ImGui::GetContentRegionAvail().x - 7.5f, 0.f})) {
-                if (dataHandler->potion.size() != 0) {
+                if (lists->potion.size() != 0) {
                     ImGui::OpenPopup(C_TRANSLATE("_ITEM_ADDPOPUP"));
                 }
             }
@@ -144,15 +168,11 @@ namespace Shared::Potion {
             ImVec2 center = ImGui::GetMainViewport()->GetCenter();
             ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
             if (ImGui::BeginPopupModal(C_TRANSLATE("_ITEM_ADDPOPUP"), NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
-                std::vector<std::string> items;
-                for (int i = 0; i < dataHandler->potion.size(); i++) {
-                    items.push_back(dataHandler->potion[i].name);
-                }
-
+                const auto& catalog = lists->catalog;
                 if (ImGui::BeginListBox("##listbox1")) {
-                    for (int i = 0; i < dataHandler->potion.size(); i++) {
+                    for (int i = 0; i < lists->potion.size(); i++) {
                         const bool is_selected = (*_popup_potionIndex == i);
-                        if (ImGui::Selectable(items[i].c_str(), is_selected)) {
+                        if (ImGui::Selectable(catalog.GetName(lists->potion[i]).c_str(), is_selected)) {
                             *_popup_potionIndex = i;
                         }
 
@@ -168,7 +188,9 @@ namespace Shared::Potion {
                     auto buttonSize = ImGui::CalcTextSize((TRANSLATE("_OK") + TRANSLATE("_CANCEL")).c_str());
                     if (ImGui::Button(C_TRANSLATE("_OK"),
                                       ImVec2(ImGui::GetWindowContentRegionMax().x * 0.45f, buttonSize.y + 15.0f))) {
-                        _potion->push_back(dataHandler->potion[*_popup_potionIndex]);
+                        if (*_popup_potionIndex < lists->potion.size()) {
+                            _potion->push_back(catalog.GetPotion(lists->potion[*_popup_potionIndex]));
+                        }
                         ImGui::CloseCurrentPopup();
                     }
 
@@ -285,6 +307,10 @@ namespace Create::Potion {
         static bool modifier1 = false;
         static bool modifier2 = false;
         static bool modifier3 = false;
+        static uint32_t gesture = 0U;
+        static uint32_t leader = 0U;
+        static uint32_t layer = manager->GetActiveLayer();
+        static uint32_t padMask = 0U;
         static bool equipSound = true;
         static bool calcDuration = false;
         static bool icon_enable = false;
@@ -313,6 +339,10 @@ namespace Create::Potion {
             modifier1 = false;
             modifier2 = false;
             modifier3 = false;
+            gesture = 0U;
+            leader = 0U;
+            layer = manager->GetActiveLayer();
+            padMask = 0U;
             equipSound = true;
             calcDuration = false;
             icon_enable = false;
@@ -351,7 +381,7 @@ namespace Create::Potion {
                 Draw::BeginGroupPanel(hotkeyLabel.c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0.0f),
                                       ImVec2(15.0f, 10.0f));
                 {
-                    Shared::Potion::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3);
+                    Shared::Potion::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3, &gesture, &leader, &layer, &padMask);
                 }
                 Draw::EndGroupPanel();
 
@@ -449,7 +479,8 @@ namespace Create::Potion {
             auto buttonSize = ImGui::CalcTextSize((TRANSLATE("_OK") + TRANSLATE("_CANCEL")).c_str());
             if (ImGui::Button(C_TRANSLATE("_OK"), {-FLT_MIN, buttonSize.y + 15.0f})) {
                 auto [result_type, result_string] =
-                    manager->IsCreateValid(name, hotkey, modifier1, modifier2, modifier3);
+                    manager->IsCreateValid(name, hotkey, modifier1, modifier2, modifier3,
+                                           static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
 
                 if (result_type == EquipsetManager::VALID_TYPE::NAME_BLANK) {
                     ImGui::OpenPopup((title + "##NAME_BLANK").c_str());
@@ -469,6 +500,10 @@ namespace Create::Potion {
                     equipset.modifier1 = modifier1;
                     equipset.modifier2 = modifier2;
                     equipset.modifier3 = modifier3;
+                    equipset.gesture = static_cast<Equipset::GESTURE>(gesture);
+                    equipset.leader = leader;
+                    equipset.layer = layer;
+                    equipset.padMask = padMask;
                     equipset.equipSound = equipSound;
                     equipset.calcDuration = calcDuration;
                     equipset.widgetIcon.enable = icon_enable;
@@ -491,7 +526,7 @@ namespace Create::Potion {
                     auto manager = EquipsetManager::GetSingleton();
                     if (!manager) logger::error("Failed to get EquipsetManager!");
 
-                    manager->Create(equipset, true);
+                    manager->Create(std::move(equipset), true);
 
                     close_popup = true;
                 }
@@ -585,6 +620,10 @@ namespace Show::Potion {
         static bool modifier1 = equipset->modifier1;
         static bool modifier2 = equipset->modifier2;
         static bool modifier3 = equipset->modifier3;
+        static uint32_t gesture = static_cast<uint32_t>(equipset->gesture);
+        static uint32_t leader = equipset->leader;
+        static uint32_t layer = equipset->layer;
+        static uint32_t padMask = equipset->padMask;
         static bool equipSound = equipset->equipSound;
         static bool calcDuration = equipset->calcDuration;
         static bool icon_enable = equipset->widgetIcon.enable;
@@ -613,6 +652,10 @@ namespace Show::Potion {
             modifier1 = equipset->modifier1;
             modifier2 = equipset->modifier2;
             modifier3 = equipset->modifier3;
+            gesture = static_cast<uint32_t>(equipset->gesture);
+            leader = equipset->leader;
+            layer = equipset->layer;
+            padMask = equipset->padMask;
             equipSound = equipset->equipSound;
             calcDuration = equipset->calcDuration;
             icon_enable = equipset->widgetIcon.enable;
@@ -643,6 +686,10 @@ namespace Show::Potion {
             modifier1 != equipset->modifier1 ||
             modifier2 != equipset->modifier2 ||
             modifier3 != equipset->modifier3 ||
+            gesture != static_cast<uint32_t>(equipset->gesture) ||
+            leader != equipset->leader ||
+            layer != equipset->layer ||
+            padMask != equipset->padMask ||
             equipSound != equipset->equipSound ||
             calcDuration != equipset->calcDuration ||
             icon_enable != equipset->widgetIcon.enable ||
@@ -717,7 +764,8 @@ namespace Show::Potion {
         if (ImGui::Button(C_TRANSLATE("_SAVECHANGES"),
                           ImVec2(ImGui::CalcTextSize(C_TRANSLATE("_SAVECHANGES")).x + 30.0f, 0))) {
             auto [result_type, result_string] =
-                manager->IsEditValid(equipset, name, hotkey, modifier1, modifier2, modifier3);
+                manager->IsEditValid(equipset, name, hotkey, modifier1, modifier2, modifier3,
+                                     static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
 
             if (result_type == EquipsetManager::VALID_TYPE::NAME_BLANK) {
                 ImGui::OpenPopup((title + "##NAME_BLANK").c_str());
@@ -732,11 +780,9 @@ namespace Show::Potion {
             } else if (result_type == EquipsetManager::VALID_TYPE::GOOD) {
                 std::string prevName = equipset->name;
 
-                equipset->name = name;
-                equipset->hotkey = hotkey;
-                equipset->modifier1 = modifier1;
-                equipset->modifier2 = modifier2;
-                equipset->modifier3 = modifier3;
+                manager->Rename(equipset, name);
+                manager->SetChord(equipset, hotkey, modifier1, modifier2, modifier3,
+                                  static_cast<Equipset::GESTURE>(gesture), leader, layer, padMask);
                 equipset->equipSound = equipSound;
                 equipset->calcDuration = calcDuration;
                 equipset->widgetIcon.enable = icon_enable;
@@ -755,6 +801,8 @@ namespace Show::Potion {
                 equipset->magicka = magicka;
                 equipset->stamina = stamina;
                 equipset->items = potion;
+                equipset->DiscardPayload();
+                equipset->MarkDirty();
                 
                 equipset->AssignAutoPotion();
                 health = equipset->health;
@@ -785,7 +833,7 @@ namespace Show::Potion {
                 Draw::BeginGroupPanel(hotkeyLabel.c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0.0f),
                                       ImVec2(15.0f, 10.0f));
                 {
-                    Shared::Potion::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3);
+                    Shared::Potion::HotkeySection(&hotkey, &modifier1, &modifier2, &modifier3, &gesture, &leader, &layer, &padMask);
                 }
                 Draw::EndGroupPanel();
 
@@ -3,6 +3,7 @@
 #include "EquipsetManager.h"
 #include "Equipment.h"
 #include "Config.h"
+#include "InventorySnapshot.h"
 
 void HUDHandler::Register() {
     auto ui = RE::UI::GetSingleton();
@@ -12,15 +13,57 @@ void HUDHandler::Register() {
     if (!hud) return;
 
     ui->AddEventSink<RE::MenuOpenCloseEvent>(hud);
+    hud->SyncBlockMenu();
     logger::info("{} Registered.", typeid(RE::MenuOpenCloseEvent).name());
 }
 
+void HUDHandler::SyncBlockMenu() {
+    auto config = ConfigHandler::GetSingleton();
+    if (!config) return;
+
+    auto UI = RE::UI::GetSingleton();
+
+    std::lock_guard<std::mutex> lock(blockMenuLock);
+    blockMenuMap.clear();
+
+    uint64_t bits = 0;
+    for (const auto& menu : config->Settings.blockMenus) {
+        if (blockMenuMap.contains(menu)) continue;
+
+        uint32_t index = static_cast<uint32_t>(blockMenuMap.size());
+        if (index >= 64) {
+            logger::warn("Too many block menus. '{}' ignored.", menu);
+            continue;
+        }
+        blockMenuMap.insert(std::make_pair(menu, index));
+
+        if (UI && UI->IsMenuOpen(menu)) {
+            bits |= (1ULL << index);
+        }
+    }
+
+    blockMenuBits.store(bits);
+}
+
 HUDHandler::EventResult HUDHandler::ProcessEvent(const RE::MenuOpenCloseEvent* _event,
                                                  RE::BSTEventSource<RE::MenuOpenCloseEvent>* _eventSource) {
     if (!_event) {
         return EventResult::kContinue;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(blockMenuLock);
+        auto it = blockMenuMap.find(_event->menuName.c_str());
+        if (it != blockMenuMap.end()) {
+            auto bit = 1ULL << it->second;
+            if (_event->opening) {
+                blockMenuBits.fetch_or(bit);
+            } else {
+                blockMenuBits.fetch_and(~bit);
+            }
+        }
+    }
+
     auto intfcStr = RE::InterfaceStrings::GetSingleton();
     if (!intfcStr) return EventResult::kContinue;
 
@@ -61,6 +104,15 @@ HUDHandler::EventResult HUDHandler::ProcessEvent(const RE::MenuOpenCloseEvent* _
         });
     }
 
+    // These menus can split, merge or rewrite extra data lists without a container event.
+    if (!_event->opening &&
+        (_event->menuName == intfcStr->inventoryMenu || _event->menuName == intfcStr->favoritesMenu ||
+         _event->menuName == intfcStr->barterMenu || _event->menuName == intfcStr->craftingMenu ||
+         _event->menuName == intfcStr->containerMenu || _event->menuName == intfcStr->giftMenu)) {
+        auto snapshot = InventorySnapshot::GetSingleton();
+        if (snapshot) snapshot->Invalidate();
+    }
+
     if (_event->menuName == intfcStr->mapMenu || _event->menuName == intfcStr->inventoryMenu ||
         _event->menuName == intfcStr->magicMenu || _event->menuName == intfcStr->tweenMenu ||
         _event->menuName == intfcStr->dialogueMenu || _event->menuName == intfcStr->barterMenu ||
@@ -4,8 +4,17 @@ class HUDHandler : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
 private:
     using EventResult = RE::BSEventNotifyControl;
 
+    // Key: menu name
+    // Value: bit index in blockMenuBits
+    std::unordered_map<std::string, uint32_t> blockMenuMap;
+    std::mutex blockMenuLock;
+    std::atomic<uint64_t> blockMenuBits{0};
+
 public:
     static void Register();
+    void SyncBlockMenu();
+
+    inline bool IsBlockMenuOpen() { return blockMenuBits.load(std::memory_order_relaxed) != 0; }
 
     virtual EventResult ProcessEvent(const RE::MenuOpenCloseEvent* _event,
                                      RE::BSTEventSource<RE::MenuOpenCloseEvent>* _eventSource) override;
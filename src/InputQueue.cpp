@@ -0,0 +1,126 @@
+#include "InputQueue.h"
+#include "EquipsetManager.h"
+#include "InputRecorder.h"
+
+int64_t InputQueue::Now() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+bool InputQueue::Push(const Record& _record) {
+    // Producer: input event sink only.
+    auto curHead = head.load(std::memory_order_relaxed);
+    auto curTail = tail.load(std::memory_order_acquire);
+    if (curHead - curTail >= capacity) {
+        // Warn on the first drop and every time the count doubles, so a stalled consumer cannot flood the log.
+        auto count = dropped.fetch_add(1U, std::memory_order_relaxed) + 1U;
+        if (std::has_single_bit(count)) {
+            logger::warn("Input queue is full; {} input events dropped so far.", count);
+        }
+        return false;
+    }
+
+    ring[curHead & (capacity - 1U)] = _record;
+    head.store(curHead + 1U, std::memory_order_release);
+    if (curHead + 1U - curTail > highWater.load(std::memory_order_relaxed)) {
+        highWater.store(curHead + 1U - curTail, std::memory_order_relaxed);
+    }
+
+    if (!isDrainQueued.exchange(true)) {
+        auto task = SKSE::GetTaskInterface();
+        if (!task) {
+            isDrainQueued.store(false);
+            return true;
+        }
+
+        task->AddTask([this]() { this->Drain(); });
+    }
+
+    return true;
+}
+
+void InputQueue::Drain() {
+    // Consumer: SKSE task, once per frame.
+    isDrainQueued.store(false);
+
+    auto manager = EquipsetManager::GetSingleton();
+    if (!manager) return;
+
+    // Presses and helds already dispatched this drain, keyed by chord; a release of the code ends them.
+    struct Pending {
+        uint64_t key;
+        uint32_t code;
+    };
+    std::array<Pending, coalesceMax> pressed;
+    uint32_t pressedCount = 0U;
+
+    auto curTail = tail.load(std::memory_order_relaxed);
+    auto curHead = head.load(std::memory_order_acquire);
+    for (; curTail != curHead; ++curTail) {
+        const auto record = ring[curTail & (capacity - 1U)];
+        bool modifier1 = record.modifier & 1U;
+        bool modifier2 = record.modifier & 2U;
+        bool modifier3 = record.modifier & 4U;
+
+        if (record.state == STATE::RELEASE) {
+            // A press after this release is a new keystroke (e.g. the second tap of a double tap), not a repeat.
+            for (uint32_t i = 0; i < pressedCount;) {
+                if (pressed[i].code == record.code) {
+                    pressed[i] = pressed[--pressedCount];
+                } else {
+                    i++;
+                }
+            }
+
+            manager->CalculateKeydown(record.code, modifier1, modifier2, modifier3, record.heldDuration);
+            continue;
+        }
+
+        // Chord keys stay below bit 53, so the state tag keeps press and held records apart.
+        auto key = EquipsetManager::GetChordKey(record.code, modifier1, modifier2, modifier3, record.padMask) |
+                   static_cast<uint64_t>(record.state) << 60;
+        auto end = pressed.begin() + pressedCount;
+        if (std::find_if(pressed.begin(), end, [key](const Pending& _elem) { return _elem.key == key; }) != end) {
+            coalesced.fetch_add(1U, std::memory_order_relaxed);
+            continue;
+        }
+        if (pressedCount < coalesceMax) {
+            pressed[pressedCount++] = {key, record.code};
+        }
+
+        auto latency = Now() - record.timestamp;
+        lastLatency.store(latency, std::memory_order_relaxed);
+        if (latency > maxLatency.load(std::memory_order_relaxed)) {
+            maxLatency.store(latency, std::memory_order_relaxed);
+        }
+        InputRecorder::GetSingleton()->AddLatency(latency);
+
+        if (record.state == STATE::HELD) {
+            manager->ProcessHeld(record.code, modifier1, modifier2, modifier3, record.heldDuration);
+        } else {
+            manager->ProcessEquip(record.code, modifier1, modifier2, modifier3, record.padMask);
+        }
+        dispatched.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    tail.store(curTail, std::memory_order_release);
+}
+
+InputQueue::Stats InputQueue::GetStats() {
+    Stats stats;
+    stats.depth = head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    stats.highWater = highWater.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced.load(std::memory_order_relaxed);
+    stats.dispatched = dispatched.load(std::memory_order_relaxed);
+    stats.lastLatency = lastLatency.load(std::memory_order_relaxed);
+    stats.maxLatency = maxLatency.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void InputQueue::LogStats() {
+    auto stats = GetStats();
+    logger::info("Input queue: {} dispatched, {} coalesced, {} dropped, high water {} of {}, max latency {}us.",
+                 stats.dispatched, stats.coalesced, stats.dropped, stats.highWater, capacity, stats.maxLatency);
+}
\ No newline at end of file
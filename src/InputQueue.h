@@ -0,0 +1,67 @@
+#pragma once
+
+class InputQueue {
+public:
+    enum class STATE : std::uint8_t { PRESS, HELD, RELEASE };
+
+    struct Record {
+        uint32_t code{0U};
+        uint8_t modifier{0U};
+        uint32_t padMask{0U};
+        STATE state{STATE::PRESS};
+        float heldDuration{0.0f};
+        int64_t timestamp{0};
+    };
+
+    struct Stats {
+        uint32_t depth{0U};
+        uint32_t highWater{0U};  // deepest the ring has been
+        uint64_t dropped{0U};
+        uint64_t coalesced{0U};
+        uint64_t dispatched{0U};
+        int64_t lastLatency{0};  // microseconds
+        int64_t maxLatency{0};   // microseconds
+    };
+
+    bool Push(const Record& _record);
+    void Drain();
+    Stats GetStats();
+    void LogStats();
+
+    static int64_t Now();
+    static uint8_t GetModifierMask(bool _modifier1, bool _modifier2, bool _modifier3) {
+        return (_modifier1 ? 1U : 0U) | (_modifier2 ? 2U : 0U) | (_modifier3 ? 4U : 0U);
+    }
+
+private:
+    static constexpr uint32_t capacity{256U};
+    static constexpr uint32_t coalesceMax{16U};
+
+    std::array<Record, capacity> ring;
+    std::atomic<uint32_t> head{0U};
+    std::atomic<uint32_t> tail{0U};
+    std::atomic<bool> isDrainQueued{false};
+
+    std::atomic<uint32_t> highWater{0U};
+    std::atomic<uint64_t> dropped{0U};
+    std::atomic<uint64_t> coalesced{0U};
+    std::atomic<uint64_t> dispatched{0U};
+    std::atomic<int64_t> lastLatency{0};
+    std::atomic<int64_t> maxLatency{0};
+
+public:
+    static InputQueue* GetSingleton() {
+        static InputQueue singleton;
+        return std::addressof(singleton);
+    }
+
+private:
+    InputQueue() {}
+    InputQueue(const InputQueue&) = delete;
+    InputQueue(InputQueue&&) = delete;
+
+    ~InputQueue() = default;
+
+    InputQueue& operator=(const InputQueue&) = delete;
+    InputQueue& operator=(InputQueue&&) = delete;
+};
\ No newline at end of file
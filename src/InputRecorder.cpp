@@ -0,0 +1,167 @@
+#include "InputRecorder.h"
+
+const std::filesystem::path input_log_path = "Data/SKSE/Plugins/UIHS/InputLog.bin";
+
+namespace {
+    constexpr std::array<char, 8> log_magic{'U', 'I', 'H', 'S', 'I', 'N', '0', '2'};
+
+    template <class T>
+    void WriteValue(std::ofstream& _stream, const T& _value) {
+        _stream.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+    }
+
+    template <class T>
+    bool ReadValue(std::ifstream& _stream, T& _value) {
+        return static_cast<bool>(_stream.read(reinterpret_cast<char*>(&_value), sizeof(T)));
+    }
+}
+
+void InputRecorder::Start() {
+    if (IsReplaying()) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    entries.reserve(1024);
+    startTime = InputQueue::Now();
+    isRecording.store(true);
+
+    logger::info("Input recording started.");
+}
+
+void InputRecorder::Stop() {
+    if (!isRecording.exchange(false)) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (Write()) {
+        logger::info("Input recording saved. ({} events)", entries.size());
+    } else {
+        logger::error("Failed to write input log!");
+    }
+}
+
+void InputRecorder::Capture(const InputQueue::Record& _record) {
+    if (!IsRecording()) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (entries.size() >= maxEntries) return;
+
+    Entry entry;
+    entry.code = _record.code;
+    entry.modifier = _record.modifier;
+    entry.padMask = _record.padMask;
+    entry.state = static_cast<uint8_t>(_record.state);
+    entry.heldDuration = _record.heldDuration;
+    entry.offset = _record.timestamp - startTime;
+    entries.push_back(entry);
+}
+
+void InputRecorder::AddLatency(int64_t _latency) {
+    if (!IsReplaying()) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    latencies.push_back(_latency);
+}
+
+bool InputRecorder::Write() {
+    std::ofstream f(input_log_path, std::ios::binary | std::ios::trunc);
+    if (!f.is_open()) return false;
+
+    f.write(log_magic.data(), log_magic.size());
+    WriteValue(f, static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        WriteValue(f, entry.code);
+        WriteValue(f, entry.modifier);
+        WriteValue(f, entry.padMask);
+        WriteValue(f, entry.state);
+        WriteValue(f, entry.heldDuration);
+        WriteValue(f, entry.offset);
+    }
+
+    return f.good();
+}
+
+bool InputRecorder::Read() {
+    std::ifstream f(input_log_path, std::ios::binary);
+    if (!f.is_open()) return false;
+
+    std::array<char, 8> magic{};
+    if (!f.read(magic.data(), magic.size()) || magic != log_magic) return false;
+
+    uint32_t count = 0U;
+    if (!ReadValue(f, count) || count > maxEntries) return false;
+
+    entries.clear();
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Entry entry;
+        if (!ReadValue(f, entry.code) || !ReadValue(f, entry.modifier) || !ReadValue(f, entry.padMask) ||
+            !ReadValue(f, entry.state) || !ReadValue(f, entry.heldDuration) || !ReadValue(f, entry.offset)) {
+            return false;
+        }
+        if (entry.state > static_cast<uint8_t>(InputQueue::STATE::RELEASE)) return false;
+
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+void InputRecorder::Replay() {
+    if (IsRecording() || isReplaying.exchange(true)) return;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!Read()) {
+            logger::warn("Failed to read input log.");
+            isReplaying.store(false);
+            return;
+        }
+        latencies.clear();
+        latencies.reserve(entries.size());
+    }
+
+    logger::info("Input replay started. ({} events)", entries.size());
+
+    // Live input is not queued while replaying, so this thread is the queue's only producer.
+    std::thread([this]() {
+        auto queue = InputQueue::GetSingleton();
+        auto begin = std::chrono::steady_clock::now();
+
+        for (const auto& entry : entries) {
+            std::this_thread::sleep_until(begin + std::chrono::microseconds(entry.offset));
+
+            InputQueue::Record record;
+            record.code = entry.code;
+            record.modifier = entry.modifier;
+            record.padMask = entry.padMask;
+            record.state = static_cast<InputQueue::STATE>(entry.state);
+            record.heldDuration = entry.heldDuration;
+            record.timestamp = InputQueue::Now();
+            queue->Push(record);
+        }
+
+        for (int i = 0; i < 100 && queue->GetStats().depth != 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        isReplaying.store(false);
+        Report();
+    }).detach();
+}
+
+void InputRecorder::Report() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (latencies.empty()) {
+        logger::info("Input replay finished. No equipset was dispatched.");
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [this](double _p) {
+        auto index = static_cast<size_t>(_p * static_cast<double>(latencies.size() - 1));
+        return latencies[index];
+    };
+
+    logger::info("Input replay finished. dispatched: {}, p50: {}us, p99: {}us, p99.9: {}us, max: {}us",
+                 latencies.size(), percentile(0.5), percentile(0.99), percentile(0.999), latencies.back());
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "InputQueue.h"
+
+// Captures the queued input stream into a compact binary log and replays it through
+// InputQueue, so hotkey latency can be measured on a repeatable sequence.
+class InputRecorder {
+public:
+    void Start();
+    void Stop();
+    void Replay();
+
+    void Capture(const InputQueue::Record& _record);
+    void AddLatency(int64_t _latency);
+
+    inline bool IsRecording() { return isRecording.load(std::memory_order_relaxed); }
+    inline bool IsReplaying() { return isReplaying.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t maxEntries{65536U};
+
+    struct Entry {
+        uint32_t code{0U};
+        uint8_t modifier{0U};
+        uint32_t padMask{0U};
+        uint8_t state{0U};
+        float heldDuration{0.0f};
+        int64_t offset{0};  // microseconds since Start
+    };
+
+    std::vector<Entry> entries;
+    std::vector<int64_t> latencies;
+    std::mutex lock;
+    int64_t startTime{0};
+
+    std::atomic<bool> isRecording{false};
+    std::atomic<bool> isReplaying{false};
+
+    bool Write();
+    bool Read();
+    void Report();
+
+public:
+    static InputRecorder* GetSingleton() {
+        static InputRecorder singleton;
+        return std::addressof(singleton);
+    }
+
+private:
+    InputRecorder() {}
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder(InputRecorder&&) = delete;
+
+    ~InputRecorder() = default;
+
+    InputRecorder& operator=(const InputRecorder&) = delete;
+    InputRecorder& operator=(InputRecorder&&) = delete;
+};
\ No newline at end of file
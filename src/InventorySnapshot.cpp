@@ -0,0 +1,52 @@
+#include "InventorySnapshot.h"
+
+const InventorySnapshot::Inventory& InventorySnapshot::Get() {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto player = RE::PlayerCharacter::GetSingleton();
+    if (!player) {
+        inventory.clear();
+        isValid = false;
+        return inventory;
+    }
+
+    if (!isValid || dirtyItems.size() > maxDirtyItems) {
+        inventory = player->GetInventory();
+        dirtyItems.clear();
+        isValid = true;
+        return inventory;
+    }
+
+    if (dirtyItems.empty()) return inventory;
+
+    for (auto item : dirtyItems) {
+        inventory.erase(item);
+    }
+
+    auto changed = player->GetInventory([this](RE::TESBoundObject& _object) {
+        return dirtyItems.contains(std::addressof(_object));
+    });
+    for (auto& [item, data] : changed) {
+        inventory.insert_or_assign(item, std::move(data));
+    }
+    dirtyItems.clear();
+
+    return inventory;
+}
+
+void InventorySnapshot::MarkDirty(RE::FormID _item) {
+    auto form = RE::TESForm::LookupByID(_item);
+    if (!form) return;
+
+    auto object = form->As<RE::TESBoundObject>();
+    if (!object) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (isValid) dirtyItems.insert(object);
+}
+
+void InventorySnapshot::Invalidate() {
+    std::lock_guard<std::mutex> guard(lock);
+    isValid = false;
+    dirtyItems.clear();
+}
\ No newline at end of file
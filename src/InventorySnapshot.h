@@ -0,0 +1,40 @@
+#pragma once
+
+// Keeps one copy of the player's inventory map for the readers that only need item counts and
+// extra data. Container and equip events mark single items stale, and the next Get() refetches
+// just those items instead of rebuilding the whole map.
+class InventorySnapshot {
+public:
+    using Inventory = RE::TESObjectREFR::InventoryItemMap;
+
+    // Game thread only; the reference stays valid until the next Get() or Invalidate().
+    const Inventory& Get();
+    void MarkDirty(RE::FormID _item);
+    // Forces a full rebuild, e.g. after a load or when a menu may have split or merged stacks.
+    void Invalidate();
+
+private:
+    // Past this many stale items a full rebuild is cheaper than filtering them out one by one.
+    static constexpr size_t maxDirtyItems{64};
+
+    Inventory inventory;
+    std::unordered_set<RE::TESBoundObject*> dirtyItems;
+    bool isValid{false};
+    std::mutex lock;
+
+public:
+    static InventorySnapshot* GetSingleton() {
+        static InventorySnapshot singleton;
+        return std::addressof(singleton);
+    }
+
+private:
+    InventorySnapshot() {}
+    InventorySnapshot(const InventorySnapshot&) = delete;
+    InventorySnapshot(InventorySnapshot&&) = delete;
+
+    ~InventorySnapshot() = default;
+
+    InventorySnapshot& operator=(const InventorySnapshot&) = delete;
+    InventorySnapshot& operator=(InventorySnapshot&&) = delete;
+};
\ No newline at end of file
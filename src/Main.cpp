@@ -3,6 +3,7 @@
 #include "Gui/GuiMenu.h"
 #include "Translate.h"
 #include "Serialize.h"
+#include "Cosave.h"
 
 #include "Event/Combat.h"
 #include "Event/Container.h"
@@ -180,6 +181,7 @@ namespace {
                     ContainerHandler::Register();
                     Scaleform::Register();
                     Translator::GetSingleton()->Load();
+                    ConfigHandler::GetSingleton()->ResolvePotionEffects();
                     break;
 
                 // Skyrim game events.
@@ -188,9 +190,14 @@ namespace {
                     // Data will be the name of the loaded save.
                 case MessagingInterface::kPostLoadGame: // Player's selected save game has finished loading.
                     // Data will be a boolean indicating whether the load was successful.
+                    break;
                 case MessagingInterface::kSaveGame: // The player has saved a game.
-                    // Data will be the save name.
+                    // Data will be the save name. Sent before the save's serialization callback runs.
+                    if (message->data) Cosave::SetSaveName(static_cast<const char*>(message->data));
+                    break;
                 case MessagingInterface::kDeleteGame: // The player deleted a saved game from within the load menu.
+                    // Data will be the save name.
+                    if (message->data) Cosave::DeleteSave(static_cast<const char*>(message->data));
                     break;
             }
         })) {
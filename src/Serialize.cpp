@@ -1,17 +1,14 @@
 #include "Serialize.h"
+#include "Cosave.h"
+#include "WidgetHandler.h"
+#include "TomlStream.h"
 #include "EquipsetManager.h"
 #include "Equipment.h"
+#include "FileWriter.h"
+#include "InventorySnapshot.h"
+#include "InputQueue.h"
 
 #include <filesystem>
-#include <toml++/toml.h>
-
-static void WriteString(SKSE::SerializationInterface* serde, const std::string& _data) {
-    if (!serde) return;
-
-    uint32_t length = _data.length();
-    serde->WriteRecordData(&length, sizeof(length));
-    serde->WriteRecordData(_data.c_str(), length);
-}
 
 static void ReadString(SKSE::SerializationInterface* serde, std::string* _dataOut) {
     if (!serde) return;
@@ -23,312 +20,466 @@ static void ReadString(SKSE::SerializationInterface* serde, std::string* _dataOu
     serde->ReadRecordData(const_cast<char*>(_dataOut->c_str()), length);
 }
 
-static uint16_t GetVersionMajor() {
-    auto plugin = SKSE::PluginDeclaration::GetSingleton();
-    if (!plugin) return 0;
-
-    return plugin->GetVersion().major();
-}
-
 namespace Serialize {
     const auto EquipsetRecord = _byteswap_ulong('HSER');
     const std::filesystem::path equipset_path = "Data/SKSE/Plugins/UIHS/Equipset.toml";
 
-    bool ExportEquipset(Type _type, SKSE::SerializationInterface* serde) {
-        auto manager = EquipsetManager::GetSingleton();
-        if (!manager) return false;
+    // Keys of one equipset table in Equipset.toml.
+    enum class FIELD : uint32_t {
+        TYPE,
+        NAME,
+        HOTKEY,
+        MODIFIER1,
+        MODIFIER2,
+        MODIFIER3,
+        GESTURE,
+        LEADER,
+        LAYER,
+        PADMASK,
+        ORDER,
+        EQUIPSOUND,
+        TOGGLEEQUIP,
+        REEQUIP,
+        CALCDURATION,
+        CYCLEPERSIST,
+        CYCLEEXPIRE,
+        CYCLERESET,
+        CYCLEINDEX,
+        ISCYCLEINIT,
+        WIDGETICON,
+        WIDGETNAME,
+        WIDGETHOTKEY,
+        WIDGETAMOUNT,
+        LEFTHAND,
+        RIGHTHAND,
+        SHOUT,
+        HEALTH,
+        MAGICKA,
+        STAMINA,
+        ITEMSCOUNT,
+        ITEMSARR,
+        COUNT
+    };
+
+    static constexpr std::array<std::string_view, static_cast<uint32_t>(FIELD::COUNT)> fieldKeys{
+        "equipset_type",         "equipset_name",         "equipset_hotkey",       "equipset_modifier1",
+        "equipset_modifier2",    "equipset_modifier3",    "equipset_gesture",      "equipset_leader",
+        "equipset_layer",        "equipset_padMask",      "equipset_order",        "equipset_equipSound",
+        "equipset_toggleEquip",  "equipset_reEquip",      "equipset_calcDuration", "equipset_cyclePersist",
+        "equipset_cycleExpire",  "equipset_cycleReset",   "equipset_cycleIndex",   "equipset_isCycleInit",
+        "equipset_widgetIcon",   "equipset_widgetName",   "equipset_widgetHotkey", "equipset_widgetAmount",
+        "equipset_lefthand",     "equipset_righthand",    "equipset_shout",        "equipset_health",
+        "equipset_magicka",      "equipset_stamina",      "equipset_itemsCount",   "equipset_itemsArr"};
+
+    static std::string_view Key(FIELD _field) { return fieldKeys[static_cast<uint32_t>(_field)]; }
+
+    static std::optional<FIELD> FindField(std::string_view _key) {
+        static const auto fieldMap = []() {
+            std::unordered_map<std::string_view, FIELD> result;
+            for (uint32_t i = 0; i < fieldKeys.size(); i++) {
+                result.emplace(fieldKeys[i], static_cast<FIELD>(i));
+            }
+            return result;
+        }();
 
-        if (_type == Type::SAVE && !serde) return false;
+        auto it = fieldMap.find(_key);
+        if (it == fieldMap.end()) return std::nullopt;
+        return it->second;
+    }
 
-        const auto& equipsetVec = manager->equipsetVec;
+    // One equipset table with its values still in text form, indexed by FIELD.
+    struct Record {
+        uint32_t id{0U};
+        std::array<std::string, static_cast<uint32_t>(FIELD::COUNT)> values;
+        std::bitset<static_cast<uint32_t>(FIELD::COUNT)> isSet;
+        std::vector<std::string> items;
 
-        auto mainTbl = toml::table{
-            {"Init",
-             toml::table{
-                 {"equipset_count", (uint32_t)equipsetVec.size()},
-             }},
+        const std::string* Get(FIELD _field) const {
+            auto index = static_cast<uint32_t>(_field);
+            return isSet[index] ? std::addressof(values[index]) : nullptr;
+        }
+
+        std::string_view GetString(FIELD _field) const {
+            auto value = Get(_field);
+            return value ? std::string_view(*value) : ""sv;
+        }
+
+        template <class T>
+        T GetNumber(FIELD _field, T _default) const {
+            auto value = Get(_field);
+            if (!value) return _default;
+
+            std::string_view text = *value;
+            if (text.starts_with('+')) text.remove_prefix(1);
+
+            T result;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), result);
+            return ec == std::errc{} ? result : _default;
+        }
+
+        bool GetBool(FIELD _field, bool _default) const {
+            auto value = Get(_field);
+            return value ? *value == "true" : _default;
+        }
+    };
+
+    // Decodes one equipset table. Called from worker threads: touches nothing but _record and _resolver.
+    static std::unique_ptr<Equipset> ParseTable(const Record& _record, Type _type, FormResolver& _resolver) {
+        auto type = _record.GetNumber<int>(FIELD::TYPE, -1);
+        if (type == -1) return nullptr;
+
+        auto ParseCommon = [&](Equipset& _equipset) {
+            _equipset.type = static_cast<Equipset::TYPE>(type);
+            _equipset.name = _record.GetString(FIELD::NAME);
+            _equipset.hotkey = _record.GetNumber<uint32_t>(FIELD::HOTKEY, 0);
+            _equipset.modifier1 = _record.GetBool(FIELD::MODIFIER1, false);
+            _equipset.modifier2 = _record.GetBool(FIELD::MODIFIER2, false);
+            _equipset.modifier3 = _record.GetBool(FIELD::MODIFIER3, false);
+            _equipset.gesture = static_cast<Equipset::GESTURE>(std::min(_record.GetNumber<uint32_t>(FIELD::GESTURE, 0), 2U));
+            _equipset.leader = _record.GetNumber<uint32_t>(FIELD::LEADER, 0);
+            _equipset.layer = _record.GetNumber<uint32_t>(FIELD::LAYER, 0);
+            _equipset.padMask = _record.GetNumber<uint32_t>(FIELD::PADMASK, 0);
+            _equipset.order = _record.GetNumber<uint32_t>(FIELD::ORDER, 0);
         };
 
-        for (int i = 0; i < equipsetVec.size(); i++) {
-            if (equipsetVec[i]->type == Equipset::TYPE::NORMAL) {
-                auto equipset = static_cast<NormalSet*>(equipsetVec[i]);
+        // Items past the end of equipset_itemsArr unpack from an empty string, as they always have.
+        auto itemsCount = _record.GetNumber<uint32_t>(FIELD::ITEMSCOUNT, 0);
+        auto GetItem = [&](uint32_t _index) {
+            return _index < _record.items.size() ? std::string_view(_record.items[_index]) : ""sv;
+        };
 
-                toml::array itemsArr;
-                for (auto item : equipset->items) {
-                    itemsArr.push_back(item.Pack());
-                }
+        if (static_cast<Equipset::TYPE>(type) == Equipset::TYPE::NORMAL) {
+            auto equipset = std::make_unique<NormalSet>();
+            ParseCommon(*equipset);
+            equipset->equipSound = _record.GetBool(FIELD::EQUIPSOUND, false);
+            equipset->toggleEquip = _record.GetBool(FIELD::TOGGLEEQUIP, false);
+            equipset->reEquip = _record.GetBool(FIELD::REEQUIP, false);
+            equipset->widgetIcon = WidgetIcon::Unpack(_record.GetString(FIELD::WIDGETICON));
+            equipset->widgetName = WidgetText::Unpack(_record.GetString(FIELD::WIDGETNAME));
+            equipset->widgetHotkey = WidgetText::Unpack(_record.GetString(FIELD::WIDGETHOTKEY));
+            DataWeapon::Unpack(_record.GetString(FIELD::LEFTHAND), equipset->lefthand, &_resolver);
+            DataWeapon::Unpack(_record.GetString(FIELD::RIGHTHAND), equipset->righthand, &_resolver);
+            DataShout::Unpack(_record.GetString(FIELD::SHOUT), equipset->shout, &_resolver);
+
+            // Sized up front: the resolver keeps pointers into the items until Resolve.
+            equipset->items.resize(itemsCount);
+            for (uint32_t j = 0; j < itemsCount; j++) {
+                DataArmor::Unpack(GetItem(j), equipset->items[j], &_resolver);
+            }
 
-                auto tbl = toml::table{
-                    {"equipset_type", static_cast<uint32_t>(equipset->type)},
-                    {"equipset_name", equipset->name},
-                    {"equipset_hotkey", equipset->hotkey},
-                    {"equipset_modifier1", equipset->modifier1},
-                    {"equipset_modifier2", equipset->modifier2},
-                    {"equipset_modifier3", equipset->modifier3},
-                    {"equipset_order", equipset->order},
-                    {"equipset_equipSound", equipset->equipSound},
-                    {"equipset_toggleEquip", equipset->toggleEquip},
-                    {"equipset_reEquip", equipset->reEquip},
-                    {"equipset_widgetIcon", equipset->widgetIcon.Pack()},
-                    {"equipset_widgetName", equipset->widgetName.Pack()},
-                    {"equipset_widgetHotkey", equipset->widgetHotkey.Pack()},
-                    {"equipset_lefthand", equipset->lefthand.Pack()},
-                    {"equipset_righthand", equipset->righthand.Pack()},
-                    {"equipset_shout", equipset->shout.Pack()},
-                    {"equipset_itemsCount", (uint32_t)equipset->items.size()},
-                    {"equipset_itemsArr", itemsArr},
-                };
-
-                mainTbl.insert(std::to_string(i), tbl);
-
-            } else if (equipsetVec[i]->type == Equipset::TYPE::POTION) {
-                auto equipset = static_cast<PotionSet*>(equipsetVec[i]);
-
-                toml::array itemsArr;
-                for (auto item : equipset->items) {
-                    itemsArr.push_back(item.Pack());
-                }
+            return equipset;
+
+        } else if (static_cast<Equipset::TYPE>(type) == Equipset::TYPE::POTION) {
+            auto equipset = std::make_unique<PotionSet>();
+            ParseCommon(*equipset);
+            equipset->equipSound = _record.GetBool(FIELD::EQUIPSOUND, false);
+            equipset->calcDuration = _record.GetBool(FIELD::CALCDURATION, false);
+            equipset->widgetIcon = WidgetIcon::Unpack(_record.GetString(FIELD::WIDGETICON));
+            equipset->widgetName = WidgetText::Unpack(_record.GetString(FIELD::WIDGETNAME));
+            equipset->widgetAmount = WidgetText::Unpack(_record.GetString(FIELD::WIDGETAMOUNT));
+            DataPotion::Unpack(_record.GetString(FIELD::HEALTH), equipset->health, &_resolver);
+            DataPotion::Unpack(_record.GetString(FIELD::MAGICKA), equipset->magicka, &_resolver);
+            DataPotion::Unpack(_record.GetString(FIELD::STAMINA), equipset->stamina, &_resolver);
+
+            // Sized up front: the resolver keeps pointers into the items until Resolve.
+            equipset->items.resize(itemsCount);
+            for (uint32_t j = 0; j < itemsCount; j++) {
+                DataPotion::Unpack(GetItem(j), equipset->items[j], &_resolver);
+            }
 
-                auto tbl = toml::table{
-                    {"equipset_type", static_cast<uint32_t>(equipset->type)},
-                    {"equipset_name", equipset->name},
-                    {"equipset_hotkey", equipset->hotkey},
-                    {"equipset_modifier1", equipset->modifier1},
-                    {"equipset_modifier2", equipset->modifier2},
-                    {"equipset_modifier3", equipset->modifier3},
-                    {"equipset_order", equipset->order},
-                    {"equipset_equipSound", equipset->equipSound},
-                    {"equipset_calcDuration", equipset->calcDuration},
-                    {"equipset_widgetIcon", equipset->widgetIcon.Pack()},
-                    {"equipset_widgetName", equipset->widgetName.Pack()},
-                    {"equipset_widgetAmount", equipset->widgetAmount.Pack()},
-                    {"equipset_health", equipset->health.Pack()},
-                    {"equipset_magicka", equipset->magicka.Pack()},
-                    {"equipset_stamina", equipset->stamina.Pack()},
-                    {"equipset_itemsCount", (uint32_t)equipset->items.size()},
-                    {"equipset_itemsArr", itemsArr},
-                };
-
-                mainTbl.insert(std::to_string(i), tbl);
-
-            } else if (equipsetVec[i]->type == Equipset::TYPE::CYCLE) {
-                auto equipset = static_cast<CycleSet*>(equipsetVec[i]);
-
-                toml::array itemsArr;
-                for (auto item : equipset->items) {
-                    itemsArr.push_back(item);
-                }
+            return equipset;
+
+        } else if (static_cast<Equipset::TYPE>(type) == Equipset::TYPE::CYCLE) {
+            auto equipset = std::make_unique<CycleSet>();
+            ParseCommon(*equipset);
+            equipset->cyclePersist = _record.GetBool(FIELD::CYCLEPERSIST, false);
+            equipset->cycleExpire = _record.GetNumber<float>(FIELD::CYCLEEXPIRE, 0.0f);
+            equipset->cycleReset = _record.GetNumber<float>(FIELD::CYCLERESET, 0.0f);
+            equipset->widgetIcon = WidgetIcon::Unpack(_record.GetString(FIELD::WIDGETICON));
+            equipset->widgetName = WidgetText::Unpack(_record.GetString(FIELD::WIDGETNAME));
+            equipset->widgetHotkey = WidgetText::Unpack(_record.GetString(FIELD::WIDGETHOTKEY));
+
+            equipset->items.reserve(itemsCount);
+            for (uint32_t j = 0; j < itemsCount; j++) {
+                equipset->items.emplace_back(GetItem(j));
+            }
 
-                auto tbl = toml::table{
-                    {"equipset_type", static_cast<uint32_t>(equipset->type)},
-                    {"equipset_name", equipset->name},
-                    {"equipset_hotkey", equipset->hotkey},
-                    {"equipset_modifier1", equipset->modifier1},
-                    {"equipset_modifier2", equipset->modifier2},
-                    {"equipset_modifier3", equipset->modifier3},
-                    {"equipset_order", equipset->order},
-                    {"equipset_cyclePersist", equipset->cyclePersist},
-                    {"equipset_cycleExpire", equipset->cycleExpire},
-                    {"equipset_cycleReset", equipset->cycleReset},
-                    {"equipset_widgetIcon", equipset->widgetIcon.Pack()},
-                    {"equipset_widgetName", equipset->widgetName.Pack()},
-                    {"equipset_widgetHotkey", equipset->widgetHotkey.Pack()},
-                    {"equipset_itemsCount", (uint32_t)equipset->items.size()},
-                    {"equipset_itemsArr", itemsArr},
-                };
-
-                if (_type == Type::SAVE) {
-                    tbl.insert("equipset_cycleIndex", equipset->cycleIndex);
-                    tbl.insert("equipset_isCycleInit", equipset->isCycleInit);
-                }
+            // Only legacy HSER save records carry cycle progress.
+            if (_type == Type::SAVE) {
+                equipset->cycleIndex = _record.GetNumber<uint32_t>(FIELD::CYCLEINDEX, 0);
+                equipset->isCycleInit = _record.GetBool(FIELD::ISCYCLEINIT, false);
+            }
+
+            return equipset;
+        }
+
+        return nullptr;
+    }
+
+    // One equipset table captured on the game thread; the TOML text is encoded from it on the writer thread.
+    struct Snapshot {
+        using Value = std::variant<std::string, uint32_t, bool, float>;
+
+        std::vector<std::pair<FIELD, Value>> values;
+        std::vector<std::string> items;
+
+        void Set(FIELD _field, Value _value) { values.emplace_back(_field, std::move(_value)); }
 
-                mainTbl.insert(std::to_string(i), tbl);
+        void Encode(TomlStream::Writer& _writer) const {
+            for (const auto& [field, value] : values) {
+                std::visit([&](const auto& _value) { _writer.Value(Key(field), _value); }, value);
             }
+            _writer.Value(Key(FIELD::ITEMSCOUNT), static_cast<uint32_t>(items.size()));
+            _writer.Array(Key(FIELD::ITEMSARR), items);
         }
+    };
+
+    static void CaptureCommon(Snapshot& _snapshot, const Equipset& _equipset) {
+        _snapshot.Set(FIELD::TYPE, static_cast<uint32_t>(_equipset.type));
+        _snapshot.Set(FIELD::NAME, _equipset.name);
+        _snapshot.Set(FIELD::HOTKEY, _equipset.hotkey);
+        _snapshot.Set(FIELD::MODIFIER1, _equipset.modifier1);
+        _snapshot.Set(FIELD::MODIFIER2, _equipset.modifier2);
+        _snapshot.Set(FIELD::MODIFIER3, _equipset.modifier3);
+        _snapshot.Set(FIELD::GESTURE, static_cast<uint32_t>(_equipset.gesture));
+        _snapshot.Set(FIELD::LEADER, _equipset.leader);
+        _snapshot.Set(FIELD::LAYER, _equipset.layer);
+        _snapshot.Set(FIELD::PADMASK, _equipset.padMask);
+        _snapshot.Set(FIELD::ORDER, _equipset.order);
+    }
 
-        if (_type == Type::FILE) {
-            std::ofstream f(equipset_path);
-            if (!f.is_open()) {
-                logger::error("Failed to export Equipset!");
-                return false;
+    static Snapshot Capture(Equipset& _equipset) {
+        Snapshot snapshot;
+        CaptureCommon(snapshot, _equipset);
+
+        if (_equipset.type == Equipset::TYPE::NORMAL) {
+            auto& equipset = static_cast<NormalSet&>(_equipset);
+            snapshot.Set(FIELD::EQUIPSOUND, equipset.equipSound);
+            snapshot.Set(FIELD::TOGGLEEQUIP, equipset.toggleEquip);
+            snapshot.Set(FIELD::REEQUIP, equipset.reEquip);
+            snapshot.Set(FIELD::WIDGETICON, equipset.widgetIcon.Pack());
+            snapshot.Set(FIELD::WIDGETNAME, equipset.widgetName.Pack());
+            snapshot.Set(FIELD::WIDGETHOTKEY, equipset.widgetHotkey.Pack());
+            snapshot.Set(FIELD::LEFTHAND, equipset.lefthand.Pack());
+            snapshot.Set(FIELD::RIGHTHAND, equipset.righthand.Pack());
+            snapshot.Set(FIELD::SHOUT, equipset.shout.Pack());
+
+            snapshot.items.reserve(equipset.items.size());
+            for (auto& item : equipset.items) {
+                snapshot.items.push_back(item.Pack());
             }
 
-            f << mainTbl;
-        } else if (_type == Type::SAVE) {
-            std::stringstream f;
-            f << mainTbl;
-            WriteString(serde, f.str());
+        } else if (_equipset.type == Equipset::TYPE::POTION) {
+            auto& equipset = static_cast<PotionSet&>(_equipset);
+            snapshot.Set(FIELD::EQUIPSOUND, equipset.equipSound);
+            snapshot.Set(FIELD::CALCDURATION, equipset.calcDuration);
+            snapshot.Set(FIELD::WIDGETICON, equipset.widgetIcon.Pack());
+            snapshot.Set(FIELD::WIDGETNAME, equipset.widgetName.Pack());
+            snapshot.Set(FIELD::WIDGETAMOUNT, equipset.widgetAmount.Pack());
+            snapshot.Set(FIELD::HEALTH, equipset.health.Pack());
+            snapshot.Set(FIELD::MAGICKA, equipset.magicka.Pack());
+            snapshot.Set(FIELD::STAMINA, equipset.stamina.Pack());
+
+            snapshot.items.reserve(equipset.items.size());
+            for (auto& item : equipset.items) {
+                snapshot.items.push_back(item.Pack());
+            }
+
+        } else if (_equipset.type == Equipset::TYPE::CYCLE) {
+            auto& equipset = static_cast<CycleSet&>(_equipset);
+            snapshot.Set(FIELD::CYCLEPERSIST, equipset.cyclePersist);
+            snapshot.Set(FIELD::CYCLEEXPIRE, equipset.cycleExpire);
+            snapshot.Set(FIELD::CYCLERESET, equipset.cycleReset);
+            snapshot.Set(FIELD::WIDGETICON, equipset.widgetIcon.Pack());
+            snapshot.Set(FIELD::WIDGETNAME, equipset.widgetName.Pack());
+            snapshot.Set(FIELD::WIDGETHOTKEY, equipset.widgetHotkey.Pack());
+            snapshot.items.assign(equipset.items.begin(), equipset.items.end());
+        }
+
+        return snapshot;
+    }
+
+    bool ExportEquipset() {
+        auto manager = EquipsetManager::GetSingleton();
+        if (!manager) return false;
+
+        // Only the packed values are captured here; the TOML text is encoded on the writer thread, straight
+        // into the file.
+        manager->MaterializeAll();
+        auto snapshots = std::make_shared<std::vector<Snapshot>>();
+        snapshots->reserve(manager->equipsetVec.size());
+        for (auto equipset : manager->equipsetVec) {
+            snapshots->push_back(Capture(*equipset));
         }
 
+        FileWriter::GetSingleton()->Write(equipset_path, [snapshots](std::ostream& _stream) {
+            TomlStream::Writer writer(_stream);
+            writer.Table("Init");
+            writer.Value("equipset_count", static_cast<uint32_t>(snapshots->size()));
+
+            for (uint32_t i = 0; i < snapshots->size(); i++) {
+                writer.Table(std::to_string(i));
+                (*snapshots)[i].Encode(writer);
+            }
+        });
         return true;
     }
 
-    bool ImportEquipset(Type _type, SKSE::SerializationInterface* serde) {
-        try {
-            auto manager = EquipsetManager::GetSingleton();
-            if (!manager) return false;
-
-            if (_type == Type::SAVE && !serde) return false;
-
-            toml::table tbl;
-            if (_type == Type::FILE) {
-                tbl = toml::parse_file(equipset_path.c_str());
-            } else if (_type == Type::SAVE) {
-                std::string data;
-                ReadString(serde, &data);
-                tbl = toml::parse(data);
+    bool ParseEquipset(Type _type, ImportBatch& _batch, SKSE::SerializationInterface* serde) {
+        if (_type == Type::SAVE && !serde) return false;
+
+        std::ifstream file;
+        std::istringstream save;
+        if (_type == Type::FILE) {
+            // A just requested export may still be queued.
+            FileWriter::GetSingleton()->Flush();
+            file.open(equipset_path, std::ios::binary);
+            if (!file.is_open()) {
+                logger::warn("Failed to open Equipset file.");
+                return false;
             }
+        } else {
+            std::string data;
+            ReadString(serde, &data);
+            save.str(std::move(data));
+        }
 
-            uint32_t equipset_count = tbl["Init"]["equipset_count"].value_or<uint32_t>(0);
-
-            for (int i = 0; i < equipset_count; i++) {
-                auto id = std::to_string(i);
-                auto type = tbl[id]["equipset_type"].value_or<int>(-1);
-                if (type == -1) continue;
-
-                if (static_cast<Equipset::TYPE>(type) == Equipset::TYPE::NORMAL) {
-                    NormalSet equipset;
-                    equipset.type = Equipset::TYPE::NORMAL;
-                    equipset.name = tbl[id]["equipset_name"].value_or<std::string>("");
-                    equipset.hotkey = tbl[id]["equipset_hotkey"].value_or<uint32_t>(0);
-                    equipset.modifier1 = tbl[id]["equipset_modifier1"].value_or<bool>(false);
-                    equipset.modifier2 = tbl[id]["equipset_modifier2"].value_or<bool>(false);
-                    equipset.modifier3 = tbl[id]["equipset_modifier3"].value_or<bool>(false);
-                    equipset.order = tbl[id]["equipset_order"].value_or<uint32_t>(0);
-                    equipset.equipSound = tbl[id]["equipset_equipSound"].value_or<bool>(false);
-                    equipset.toggleEquip = tbl[id]["equipset_toggleEquip"].value_or<bool>(false);
-                    equipset.reEquip = tbl[id]["equipset_reEquip"].value_or<bool>(false);
-
-                    auto packedWidgetIcon = tbl[id]["equipset_widgetIcon"].value_or<std::string>("");
-                    auto widgetIcon = WidgetIcon::Unpack(packedWidgetIcon);
-                    equipset.widgetIcon = widgetIcon;
-
-                    auto packedWidgetName = tbl[id]["equipset_widgetName"].value_or<std::string>("");
-                    auto widgetName = WidgetText::Unpack(packedWidgetName);
-                    equipset.widgetName = widgetName;
-
-                    auto packedWidgetHotkey = tbl[id]["equipset_widgetHotkey"].value_or<std::string>("");
-                    auto widgetHotkey = WidgetText::Unpack(packedWidgetHotkey);
-                    equipset.widgetHotkey = widgetHotkey;
-
-                    auto packedLefthand = tbl[id]["equipset_lefthand"].value_or<std::string>("");
-                    auto lefthand = DataWeapon::Unpack(packedLefthand);
-                    equipset.lefthand = lefthand;
-
-                    auto packedRighthand = tbl[id]["equipset_righthand"].value_or<std::string>("");
-                    auto righthand = DataWeapon::Unpack(packedRighthand);
-                    equipset.righthand = righthand;
-
-                    auto packedShout = tbl[id]["equipset_shout"].value_or<std::string>("");
-                    auto shout = DataShout::Unpack(packedShout);
-                    equipset.shout = shout;
-
-                    std::vector<DataArmor> items;
-                    auto itemsCount = tbl[id]["equipset_itemsCount"].value_or<uint32_t>(0);
-                    for (int j = 0; j < itemsCount; j++) {
-                        auto packedItem = tbl[id]["equipset_itemsArr"][j].value_or<std::string>("");
-                        auto item = DataArmor::Unpack(packedItem);
-                        items.push_back(item);
-                    }
-                    equipset.items = items;
-
-                    manager->Create(equipset, false);
-
-                } else if (static_cast<Equipset::TYPE>(type) == Equipset::TYPE::POTION) {
-                    PotionSet equipset;
-                    equipset.type = Equipset::TYPE::POTION;
-                    equipset.name = tbl[id]["equipset_name"].value_or<std::string>("");
-                    equipset.hotkey = tbl[id]["equipset_hotkey"].value_or<uint32_t>(0);
-                    equipset.modifier1 = tbl[id]["equipset_modifier1"].value_or<bool>(false);
-                    equipset.modifier2 = tbl[id]["equipset_modifier2"].value_or<bool>(false);
-                    equipset.modifier3 = tbl[id]["equipset_modifier3"].value_or<bool>(false);
-                    equipset.order = tbl[id]["equipset_order"].value_or<uint32_t>(0);
-                    equipset.equipSound = tbl[id]["equipset_equipSound"].value_or<bool>(false);
-                    equipset.calcDuration = tbl[id]["equipset_calcDuration"].value_or<bool>(false);
-
-                    auto packedWidgetIcon = tbl[id]["equipset_widgetIcon"].value_or<std::string>("");
-                    auto widgetIcon = WidgetIcon::Unpack(packedWidgetIcon);
-                    equipset.widgetIcon = widgetIcon;
-
-                    auto packedWidgetName = tbl[id]["equipset_widgetName"].value_or<std::string>("");
-                    auto widgetName = WidgetText::Unpack(packedWidgetName);
-                    equipset.widgetName = widgetName;
-
-                    auto packedWidgetAmount = tbl[id]["equipset_widgetAmount"].value_or<std::string>("");
-                    auto widgetAmount = WidgetText::Unpack(packedWidgetAmount);
-                    equipset.widgetAmount = widgetAmount;
-
-                    auto packedHealth = tbl[id]["equipset_health"].value_or<std::string>("");
-                    auto health = DataPotion::Unpack(packedHealth);
-                    equipset.health = health;
-
-                    auto packedMagicka = tbl[id]["equipset_magicka"].value_or<std::string>("");
-                    auto magicka = DataPotion::Unpack(packedMagicka);
-                    equipset.magicka = magicka;
-
-                    auto packedStamina = tbl[id]["equipset_stamina"].value_or<std::string>("");
-                    auto stamina = DataPotion::Unpack(packedStamina);
-                    equipset.stamina = stamina;
-
-                    std::vector<DataPotion> items;
-                    auto itemsCount = tbl[id]["equipset_itemsCount"].value_or<uint32_t>(0);
-                    for (int j = 0; j < itemsCount; j++) {
-                        auto packedItem = tbl[id]["equipset_itemsArr"][j].value_or<std::string>("");
-                        auto item = DataPotion::Unpack(packedItem);
-                        items.push_back(item);
-                    }
-                    equipset.items = items;
-
-                    manager->Create(equipset, false);
-                } else if (static_cast<Equipset::TYPE>(type) == Equipset::TYPE::CYCLE) {
-                    CycleSet equipset;
-                    equipset.type = Equipset::TYPE::CYCLE;
-                    equipset.name = tbl[id]["equipset_name"].value_or<std::string>("");
-                    equipset.hotkey = tbl[id]["equipset_hotkey"].value_or<uint32_t>(0);
-                    equipset.modifier1 = tbl[id]["equipset_modifier1"].value_or<bool>(false);
-                    equipset.modifier2 = tbl[id]["equipset_modifier2"].value_or<bool>(false);
-                    equipset.modifier3 = tbl[id]["equipset_modifier3"].value_or<bool>(false);
-                    equipset.order = tbl[id]["equipset_order"].value_or<uint32_t>(0);
-                    equipset.cyclePersist = tbl[id]["equipset_cyclePersist"].value_or<bool>(false);
-                    equipset.cycleExpire = tbl[id]["equipset_cycleExpire"].value_or<float>(0.0f);
-                    equipset.cycleReset = tbl[id]["equipset_cycleReset"].value_or<float>(0.0f);
-
-                    auto packedWidgetIcon = tbl[id]["equipset_widgetIcon"].value_or<std::string>("");
-                    auto widgetIcon = WidgetIcon::Unpack(packedWidgetIcon);
-                    equipset.widgetIcon = widgetIcon;
-
-                    auto packedWidgetName = tbl[id]["equipset_widgetName"].value_or<std::string>("");
-                    auto widgetName = WidgetText::Unpack(packedWidgetName);
-                    equipset.widgetName = widgetName;
-
-                    auto packedWidgetHotkey = tbl[id]["equipset_widgetHotkey"].value_or<std::string>("");
-                    auto widgetHotkey = WidgetText::Unpack(packedWidgetHotkey);
-                    equipset.widgetHotkey = widgetHotkey;
-
-                    std::vector<std::string> items;
-                    auto itemsCount = tbl[id]["equipset_itemsCount"].value_or<uint32_t>(0);
-                    for (int j = 0; j < itemsCount; j++) {
-                        auto item = tbl[id]["equipset_itemsArr"][j].value_or<std::string>("");
-                        items.push_back(item);
-                    }
-                    equipset.items = items;
+        // Tables are read one at a time and handed to workers in chunks; each chunk decodes with its own resolver.
+        // Only a bounded number of chunks are in flight, so memory follows the set count, not the file size.
+        struct Chunk {
+            std::vector<Record> records;
+            FormResolver resolver;
+            std::vector<std::pair<uint32_t, std::unique_ptr<Equipset>>> parsed;
+        };
+
+        static constexpr uint32_t chunkSize{64U};
+        auto maxInFlight = std::max(std::thread::hardware_concurrency(), 1U);
+        std::deque<std::pair<std::unique_ptr<Chunk>, std::future<void>>> inFlight;
+        std::vector<std::pair<uint32_t, std::unique_ptr<Equipset>>> parsed;
 
-                    if (_type == Type::SAVE) {
-                        equipset.cycleIndex = tbl[id]["equipset_cycleIndex"].value_or<uint32_t>(0);
-                        equipset.isCycleInit = tbl[id]["equipset_isCycleInit"].value_or<bool>(false);
+        auto Collect = [&](Chunk& _chunk) {
+            _batch.resolver.Merge(_chunk.resolver);
+            for (auto& elem : _chunk.parsed) {
+                if (elem.second) parsed.push_back(std::move(elem));
+            }
+        };
+
+        auto Dispatch = [&](std::unique_ptr<Chunk> _chunk) {
+            if (inFlight.size() >= maxInFlight) {
+                inFlight.front().second.get();
+                Collect(*inFlight.front().first);
+                inFlight.pop_front();
+            }
+
+            auto chunk = _chunk.get();
+            auto future = std::async(std::launch::async, [chunk, _type]() {
+                for (const auto& record : chunk->records) {
+                    chunk->parsed.emplace_back(record.id, ParseTable(record, _type, chunk->resolver));
+                }
+            });
+            inFlight.emplace_back(std::move(_chunk), std::move(future));
+        };
+
+        TomlStream::Reader reader(_type == Type::FILE ? static_cast<std::istream&>(file) : save);
+        std::optional<uint32_t> equipset_count;
+        auto chunk = std::make_unique<Chunk>();
+        chunk->records.reserve(chunkSize);
+        Record* record = nullptr;
+        std::string currentTable;
+
+        while (reader.Next()) {
+            if (reader.GetTable() != currentTable || !record) {
+                currentTable = reader.GetTable();
+                record = nullptr;
+
+                uint32_t id;
+                auto [ptr, ec] = std::from_chars(currentTable.data(), currentTable.data() + currentTable.size(), id);
+                if (ec == std::errc{} && ptr == currentTable.data() + currentTable.size()) {
+                    if (chunk->records.size() == chunkSize) {
+                        Dispatch(std::move(chunk));
+                        chunk = std::make_unique<Chunk>();
+                        chunk->records.reserve(chunkSize);
                     }
+                    record = std::addressof(chunk->records.emplace_back());
+                    record->id = id;
+                }
+            }
 
-                    manager->Create(equipset, false);
+            if (!record) {
+                if (currentTable == "Init" && reader.GetKey() == "equipset_count") {
+                    uint32_t count;
+                    const auto& value = reader.GetValue();
+                    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), count);
+                    if (ec == std::errc{}) equipset_count = count;
                 }
+                continue;
             }
 
-            logger::info("Equipset loaded.");
-        } catch (const toml::parse_error& err) {
-            logger::warn("Failed to parse Equipset file.\nError: {}", err.description());
+            auto field = FindField(reader.GetKey());
+            if (!field) continue;
 
+            if (*field == FIELD::ITEMSARR) {
+                record->items = reader.GetValues();
+            } else {
+                auto index = static_cast<uint32_t>(*field);
+                record->values[index] = reader.GetValue();
+                record->isSet[index] = true;
+            }
+        }
+
+        if (!chunk->records.empty()) Dispatch(std::move(chunk));
+        while (!inFlight.empty()) {
+            inFlight.front().second.get();
+            Collect(*inFlight.front().first);
+            inFlight.pop_front();
+        }
+
+        if (!reader.IsGood()) {
+            logger::warn("Failed to parse Equipset file.");
             return false;
         }
 
+        // Tables may appear in any order; sets are created in id order, and only ids below equipset_count count.
+        std::ranges::sort(parsed, {}, &std::pair<uint32_t, std::unique_ptr<Equipset>>::first);
+        for (auto& [id, equipset] : parsed) {
+            if (equipset_count && id >= *equipset_count) continue;
+            _batch.equipsets.push_back(std::move(equipset));
+        }
+
+        return true;
+    }
+
+    void CommitEquipset(ImportBatch& _batch) {
+        auto manager = EquipsetManager::GetSingleton();
+        if (!manager) return;
+
+        auto widgetHandler = WidgetHandler::GetSingleton();
+        if (!widgetHandler) return;
+
+        _batch.resolver.Resolve();
+
+        // Every set's widgets go to the widget menu as one tasklet.
+        widgetHandler->BeginBatch();
+        for (auto& elem : _batch.equipsets) {
+            if (elem->type == Equipset::TYPE::NORMAL) {
+                manager->Create(std::move(*static_cast<NormalSet*>(elem.get())), false);
+            } else if (elem->type == Equipset::TYPE::POTION) {
+                manager->Create(std::move(*static_cast<PotionSet*>(elem.get())), false);
+            } else if (elem->type == Equipset::TYPE::CYCLE) {
+                manager->Create(std::move(*static_cast<CycleSet*>(elem.get())), false);
+            }
+        }
+        widgetHandler->EndBatch();
+        _batch.equipsets.clear();
+
+        logger::info("Equipset loaded.");
+    }
+
+    bool ImportEquipset(Type _type, SKSE::SerializationInterface* serde) {
+        ImportBatch batch;
+        if (!ParseEquipset(_type, batch, serde)) return false;
+
+        CommitEquipset(batch);
         return true;
     }
 
@@ -336,12 +487,15 @@ namespace Serialize {
         auto manager = EquipsetManager::GetSingleton();
         if (!manager) return;
 
-        if (!serde->OpenRecord(EquipsetRecord, GetVersionMajor())) {
+        if (!serde->OpenRecord(Cosave::EquipsetRecord, Cosave::EquipsetVersion)) {
             logger::error("Unable to open record to write cosave data.");
             return;
         }
 
-        ExportEquipset(Type::SAVE, serde);
+        Cosave::WriteEquipsets(serde);
+
+        auto queue = InputQueue::GetSingleton();
+        if (queue) queue->LogStats();
     }
 
     void OnRevert(SKSE::SerializationInterface* serde) {
@@ -349,6 +503,10 @@ namespace Serialize {
         if (!manager) return;
 
         manager->RemoveAll();
+        Cosave::ClearCache();
+
+        auto snapshot = InventorySnapshot::GetSingleton();
+        if (snapshot) snapshot->Invalidate();
     }
 
     void OnGameLoaded(SKSE::SerializationInterface* serde) {
@@ -364,12 +522,15 @@ namespace Serialize {
         std::string packedData;
 
         while (serde->GetNextRecordInfo(type, version, size)) {
-            if (type == EquipsetRecord && version == GetVersionMajor()) {
+            if (type == Cosave::EquipsetRecord && version == Cosave::EquipsetVersion) {
+                Cosave::ReadEquipsets(serde, size);
+                manager->SyncSortOrder();
+            } else if (type == EquipsetRecord) {
+                // Saves written before the binary record; they are rewritten in the new format on the next save.
                 ImportEquipset(Type::SAVE, serde);
                 manager->SyncSortOrder();
             } else {
                 logger::warn("Unknown record type in cosave.");
-                __assume(false);
             }
         }
     }
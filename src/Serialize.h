@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Equipset.h"
+#include "FormResolver.h"
+
 namespace Serialize {
     enum class Type {
         SAVE,
@@ -9,6 +12,19 @@ namespace Serialize {
     void OnRevert(SKSE::SerializationInterface* serde);
     void OnGameLoaded(SKSE::SerializationInterface* serde);
 
-    bool ExportEquipset(Type _type, SKSE::SerializationInterface* serde = nullptr);
+    // Queues a write of Equipset.toml; must run on the game thread. Saves use the binary cosave record
+    // (see Cosave.h).
+    bool ExportEquipset();
+    // Type::SAVE reads the legacy HSER record of saves made before the binary record.
     bool ImportEquipset(Type _type, SKSE::SerializationInterface* serde = nullptr);
+
+    // Equipsets decoded but not yet handed to EquipsetManager; their form references resolve on commit.
+    struct ImportBatch {
+        FormResolver resolver;
+        std::vector<std::unique_ptr<Equipset>> equipsets;
+    };
+
+    // Parsing may run on any thread; committing must run on the game thread.
+    bool ParseEquipset(Type _type, ImportBatch& _batch, SKSE::SerializationInterface* serde = nullptr);
+    void CommitEquipset(ImportBatch& _batch);
 }  // namespace Serialize
\ No newline at end of file
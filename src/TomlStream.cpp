@@ -0,0 +1,339 @@
+#include "TomlStream.h"
+
+namespace {
+    bool IsBareKeyChar(char _c) {
+        return (_c >= 'A' && _c <= 'Z') || (_c >= 'a' && _c <= 'z') || (_c >= '0' && _c <= '9') || _c == '_' ||
+               _c == '-';
+    }
+
+    void AppendUtf8(std::string& _out, uint32_t _code) {
+        if (_code < 0x80) {
+            _out += static_cast<char>(_code);
+        } else if (_code < 0x800) {
+            _out += static_cast<char>(0xC0 | (_code >> 6));
+            _out += static_cast<char>(0x80 | (_code & 0x3F));
+        } else if (_code < 0x10000) {
+            _out += static_cast<char>(0xE0 | (_code >> 12));
+            _out += static_cast<char>(0x80 | ((_code >> 6) & 0x3F));
+            _out += static_cast<char>(0x80 | (_code & 0x3F));
+        } else {
+            _out += static_cast<char>(0xF0 | (_code >> 18));
+            _out += static_cast<char>(0x80 | ((_code >> 12) & 0x3F));
+            _out += static_cast<char>(0x80 | ((_code >> 6) & 0x3F));
+            _out += static_cast<char>(0x80 | (_code & 0x3F));
+        }
+    }
+}
+
+namespace TomlStream {
+    void Writer::Table(std::string_view _name) {
+        if (!buffer.empty()) buffer += '\n';
+
+        buffer += '[';
+        Key(_name);
+        buffer += ']';
+        EndLine();
+    }
+
+    void Writer::Value(std::string_view _key, std::string_view _value) {
+        Key(_key);
+        buffer += " = ";
+        String(_value);
+        EndLine();
+    }
+
+    void Writer::Value(std::string_view _key, uint32_t _value) {
+        Key(_key);
+        buffer += " = ";
+
+        char text[16];
+        auto [ptr, ec] = std::to_chars(text, text + sizeof(text), _value);
+        buffer.append(text, ptr);
+        EndLine();
+    }
+
+    void Writer::Value(std::string_view _key, bool _value) {
+        Key(_key);
+        buffer += _value ? " = true" : " = false";
+        EndLine();
+    }
+
+    void Writer::Value(std::string_view _key, float _value) {
+        Key(_key);
+        buffer += " = ";
+
+        if (std::isnan(_value)) {
+            buffer += "nan";
+        } else if (std::isinf(_value)) {
+            buffer += _value < 0.0f ? "-inf" : "inf";
+        } else {
+            char text[32];
+            auto [ptr, ec] = std::to_chars(text, text + sizeof(text), _value);
+            std::string_view written(text, ptr - text);
+            buffer += written;
+            // A TOML float needs a fraction or an exponent, otherwise it reads back as an integer.
+            if (written.find_first_of(".e") == std::string_view::npos) buffer += ".0";
+        }
+        EndLine();
+    }
+
+    void Writer::Array(std::string_view _key, const std::vector<std::string>& _values) {
+        Key(_key);
+        buffer += " = [";
+        for (size_t i = 0; i < _values.size(); i++) {
+            buffer += i == 0 ? " " : ", ";
+            String(_values[i]);
+        }
+        buffer += _values.empty() ? "]" : " ]";
+        EndLine();
+    }
+
+    void Writer::Flush() {
+        if (buffer.empty()) return;
+
+        stream.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    void Writer::Key(std::string_view _key) {
+        if (!_key.empty() && std::ranges::all_of(_key, IsBareKeyChar)) {
+            buffer += _key;
+        } else {
+            String(_key);
+        }
+    }
+
+    void Writer::String(std::string_view _value) {
+        buffer += '"';
+        for (auto c : _value) {
+            switch (c) {
+                case '"':
+                    buffer += "\\\"";
+                    break;
+                case '\\':
+                    buffer += "\\\\";
+                    break;
+                case '\n':
+                    buffer += "\\n";
+                    break;
+                case '\r':
+                    buffer += "\\r";
+                    break;
+                case '\t':
+                    buffer += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20 || c == 0x7F) {
+                        buffer += fmt::format("\\u{:04X}", static_cast<unsigned char>(c));
+                    } else {
+                        buffer += c;
+                    }
+                    break;
+            }
+        }
+        buffer += '"';
+    }
+
+    void Writer::EndLine() {
+        buffer += '\n';
+        if (buffer.size() >= flushSize) Flush();
+    }
+
+    bool Reader::Next() {
+        while (isGood) {
+            SkipSpace();
+            if (rest.empty() || rest.front() == '#') {
+                if (!NextLine()) return false;
+                continue;
+            }
+
+            if (rest.front() == '[') {
+                rest.remove_prefix(1);
+                SkipSpace();
+                if (!rest.empty() && rest.front() == '[') return Fail();  // Arrays of tables are not part of the schema.
+                if (!ParseKey(table)) return false;
+
+                SkipSpace();
+                if (rest.empty() || rest.front() != ']') return Fail();
+                rest.remove_prefix(1);
+                continue;
+            }
+
+            if (!ParseKey(key)) return false;
+
+            SkipSpace();
+            if (rest.empty() || rest.front() != '=') return Fail();
+            rest.remove_prefix(1);
+            SkipSpace();
+
+            values.clear();
+            isArray = !rest.empty() && rest.front() == '[';
+            if (isArray) {
+                rest.remove_prefix(1);
+                if (!ParseArray()) return false;
+                value.clear();
+            } else if (!ParseScalar(value)) {
+                return false;
+            }
+
+            SkipSpace();
+            if (!rest.empty() && rest.front() != '#') return Fail();
+            rest = {};
+            return true;
+        }
+
+        return false;
+    }
+
+    bool Reader::NextLine() {
+        if (!std::getline(stream, line)) return false;
+
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        rest = line;
+        return true;
+    }
+
+    void Reader::SkipSpace() {
+        while (!rest.empty() && (rest.front() == ' ' || rest.front() == '\t')) {
+            rest.remove_prefix(1);
+        }
+    }
+
+    bool Reader::ParseKey(std::string& _out) {
+        if (!rest.empty() && (rest.front() == '"' || rest.front() == '\'')) return ParseScalar(_out);
+
+        size_t length = 0;
+        while (length < rest.size() && IsBareKeyChar(rest[length])) {
+            length++;
+        }
+        if (length == 0) return Fail();
+
+        _out.assign(rest.substr(0, length));
+        rest.remove_prefix(length);
+        return true;
+    }
+
+    bool Reader::ParseScalar(std::string& _out) {
+        _out.clear();
+        if (rest.empty()) return Fail();
+
+        if (rest.front() == '\'') {
+            auto end = rest.find('\'', 1);
+            if (end == std::string_view::npos) return Fail();
+
+            _out.assign(rest.substr(1, end - 1));
+            rest.remove_prefix(end + 1);
+            return true;
+        }
+
+        if (rest.front() != '"') {
+            size_t length = 0;
+            while (length < rest.size() && rest[length] != ',' && rest[length] != ']' && rest[length] != '#' &&
+                   rest[length] != ' ' && rest[length] != '\t') {
+                length++;
+            }
+            if (length == 0) return Fail();
+
+            _out.assign(rest.substr(0, length));
+            rest.remove_prefix(length);
+            return true;
+        }
+
+        rest.remove_prefix(1);
+        while (!rest.empty()) {
+            auto c = rest.front();
+            rest.remove_prefix(1);
+
+            if (c == '"') return true;
+            if (c != '\\') {
+                _out += c;
+                continue;
+            }
+
+            if (rest.empty()) return Fail();
+            auto escape = rest.front();
+            rest.remove_prefix(1);
+            switch (escape) {
+                case 'b':
+                    _out += '\b';
+                    break;
+                case 't':
+                    _out += '\t';
+                    break;
+                case 'n':
+                    _out += '\n';
+                    break;
+                case 'f':
+                    _out += '\f';
+                    break;
+                case 'r':
+                    _out += '\r';
+                    break;
+                case '"':
+                    _out += '"';
+                    break;
+                case '\\':
+                    _out += '\\';
+                    break;
+                case 'u':
+                case 'U': {
+                    size_t digits = escape == 'u' ? 4 : 8;
+                    uint32_t code = 0;
+                    if (rest.size() < digits) return Fail();
+
+                    auto [ptr, ec] = std::from_chars(rest.data(), rest.data() + digits, code, 16);
+                    if (ec != std::errc{} || ptr != rest.data() + digits) return Fail();
+
+                    AppendUtf8(_out, code);
+                    rest.remove_prefix(digits);
+                    break;
+                }
+                default:
+                    return Fail();
+            }
+        }
+
+        return Fail();  // Unterminated; multi-line strings are not part of the schema.
+    }
+
+    bool Reader::ParseArray() {
+        // Arrays may span lines, with comments and a trailing comma.
+        while (true) {
+            SkipSpace();
+            if (rest.empty() || rest.front() == '#') {
+                if (!NextLine()) return Fail();
+                continue;
+            }
+
+            if (rest.front() == ']') {
+                rest.remove_prefix(1);
+                return true;
+            }
+
+            if (!ParseScalar(values.emplace_back())) return false;
+
+            while (true) {
+                SkipSpace();
+                if (rest.empty() || rest.front() == '#') {
+                    if (!NextLine()) return Fail();
+                    continue;
+                }
+                break;
+            }
+
+            if (rest.front() == ',') {
+                rest.remove_prefix(1);
+            } else if (rest.front() != ']') {
+                return Fail();
+            }
+        }
+    }
+
+    bool Reader::Fail() {
+        if (isGood) logger::warn("Malformed TOML at line {}.", lineNumber);
+
+        isGood = false;
+        return false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+// Streaming reader and writer for the flat TOML subset used by Equipset.toml: [table] headers, "key = value"
+// lines with strings, numbers and booleans, and arrays of those. Nothing is kept beyond the current entry.
+namespace TomlStream {
+    class Writer {
+    public:
+        explicit Writer(std::ostream& _stream) : stream(_stream) { buffer.reserve(flushSize * 2); }
+        ~Writer() { Flush(); }
+
+        void Table(std::string_view _name);
+        void Value(std::string_view _key, std::string_view _value);
+        void Value(std::string_view _key, const char* _value) { Value(_key, std::string_view(_value)); }
+        void Value(std::string_view _key, const std::string& _value) { Value(_key, std::string_view(_value)); }
+        void Value(std::string_view _key, uint32_t _value);
+        void Value(std::string_view _key, bool _value);
+        void Value(std::string_view _key, float _value);
+        void Array(std::string_view _key, const std::vector<std::string>& _values);
+        void Flush();
+
+    private:
+        static constexpr size_t flushSize{64 * 1024};
+
+        std::ostream& stream;
+        std::string buffer;
+
+        void Key(std::string_view _key);
+        void String(std::string_view _value);
+        void EndLine();
+    };
+
+    class Reader {
+    public:
+        explicit Reader(std::istream& _stream) : stream(_stream) {}
+
+        // Advances to the next "key = value" entry; table headers in between update GetTable.
+        // Returns false at the end of the stream or on the first syntax error (see IsGood).
+        bool Next();
+
+        bool IsGood() const { return isGood; }
+        uint32_t GetLine() const { return lineNumber; }
+        const std::string& GetTable() const { return table; }
+        const std::string& GetKey() const { return key; }
+        // Strings are unescaped; numbers and booleans are kept as written.
+        const std::string& GetValue() const { return value; }
+        bool IsArray() const { return isArray; }
+        const std::vector<std::string>& GetValues() const { return values; }
+
+    private:
+        std::istream& stream;
+        std::string line;
+        std::string_view rest;
+        uint32_t lineNumber{0U};
+        bool isGood{true};
+
+        std::string table;
+        std::string key;
+        std::string value;
+        bool isArray{false};
+        std::vector<std::string> values;
+
+        bool NextLine();
+        void SkipSpace();
+        bool ParseKey(std::string& _out);
+        bool ParseScalar(std::string& _out);
+        bool ParseArray();
+        bool Fail();
+    };
+}
\ No newline at end of file
@@ -3,11 +3,36 @@
 #include "Config.h"
 
 void WidgetHandler::AddWidgetMenuTask(WidgetTasklet a_task) {
+    if (_isBatching) {
+        _batch.push_back(std::move(a_task));
+        return;
+    }
+
     OpenWidgetMenu();
     Locker locker(_lock);
     _WidgetMenuTaskQueue.push_back(std::move(a_task));
 }
 
+void WidgetHandler::BeginBatch() {
+    _isBatching = true;
+}
+
+void WidgetHandler::EndBatch() {
+    if (!_isBatching) return;
+
+    _isBatching = false;
+    if (_batch.empty()) return;
+
+    auto batch = std::make_shared<std::vector<WidgetTasklet>>(std::move(_batch));
+    _batch.clear();
+
+    AddWidgetMenuTask([batch](WidgetMenu& a_menu) {
+        for (auto& task : *batch) {
+            task(a_menu);
+        }
+    });
+}
+
 void WidgetHandler::ProcessWidgetMenu(WidgetMenu& a_menu) {
     if (!_WidgetMenuTaskQueue.empty()) {
         for (auto& task : _WidgetMenuTaskQueue) {
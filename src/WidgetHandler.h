@@ -18,6 +18,9 @@ public:
         task->AddTask([this]() { _refreshWidgetMenu = true; });
     }
 
+    void BeginBatch();
+    void EndBatch();
+
     void OpenWidgetMenu();
     void CloseWidgetMenu();
 
@@ -40,7 +43,7 @@ public:
     bool ExpireFunc();
 
 protected:
-    friend class WidgetMenu;
+    friend WidgetMenu;
 
     void ProcessWidgetMenu(WidgetMenu& a_menu);
 
@@ -52,6 +55,8 @@ private:
     void AddWidgetMenuTask(WidgetTasklet a_task);
 
     std::vector<WidgetTasklet> _WidgetMenuTaskQueue;
+    static inline thread_local std::vector<WidgetTasklet> _batch;
+    static inline thread_local bool _isBatching{false};
 
     mutable Lock _lock;
     bool _refreshWidgetMenu{false};
@@ -0,0 +1,50 @@
+#include "ChordAutomaton.h"
+#include "EquipsetManager.h"
+#include "Config.h"
+
+#include "Harness.h"
+
+namespace {
+    constexpr uint32_t leaderKey{632U};
+    constexpr uint32_t hotkey{30U};
+
+    uint64_t Key(const uint32_t& _code, bool _modifier1 = false, bool _modifier2 = false) {
+        return EquipsetManager::GetChordKey(_code, _modifier1, _modifier2, false);
+    }
+
+    void Bind(NormalSet& _equipset, const uint32_t& _handle, bool _modifier1, bool _modifier2) {
+        _equipset.handle = _handle;
+        _equipset.hotkey = hotkey;
+        _equipset.modifier1 = _modifier1;
+        _equipset.modifier2 = _modifier2;
+        _equipset.leader = leaderKey;
+    }
+}
+
+// Modifiers held down after the leader is tapped still reach the leader's chords instead of ending the sequence.
+TEST_CASE(LeaderChordTakesModifiersPressedAfterLeader) {
+    auto config = ConfigHandler::GetSingleton();
+    ChordAutomaton automaton;
+    NormalSet plain;
+    NormalSet modified;
+    Bind(plain, 1U, false, false);
+    Bind(modified, 2U, true, true);
+    REQUIRE(automaton.Add(&plain));
+    REQUIRE(automaton.Add(&modified));
+
+    CHECK_EQ(automaton.Press(Key(leaderKey)), 0U);
+    automaton.Release(Key(leaderKey), 0.1f);
+    CHECK_EQ(automaton.Press(Key(config->Settings.modifier1)), 0U);
+    CHECK_EQ(automaton.Press(Key(config->Settings.modifier2, true)), 0U);
+    CHECK_EQ(automaton.Press(Key(hotkey, true, true)), 2U);
+    automaton.Release(Key(hotkey, true, true), 0.1f);
+
+    // Without a pending leader the chord does not fire, and any other key still ends the sequence.
+    CHECK_EQ(automaton.Press(Key(hotkey, true, true)), 0U);
+    CHECK_EQ(automaton.Press(Key(leaderKey)), 0U);
+    CHECK_EQ(automaton.Press(Key(hotkey + 1U)), 0U);
+    CHECK_EQ(automaton.Press(Key(hotkey)), 0U);
+
+    CHECK_EQ(automaton.Press(Key(leaderKey)), 0U);
+    CHECK_EQ(automaton.Press(Key(hotkey)), 1U);
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "Codec.h"
+#include "Data.h"
+
+#include "Harness.h"
+
+namespace {
+    using DATATYPE = Data::DATATYPE;
+
+    // A few plugins of each kind and one form in each, registered once for every test.
+    struct Forms {
+        RE::TESForm* sword;
+        RE::TESForm* boots;
+        RE::TESForm* shout;
+        RE::TESForm* brew;
+
+        static const Forms& Get() {
+            static const Forms forms = []() {
+                auto dataHandler = RE::TESDataHandler::GetSingleton();
+                auto skyrim = dataHandler->AddFile("Skyrim.esm", 0x00);
+                auto dawnguard = dataHandler->AddFile("Dawnguard.esm", 0x02);
+                auto light = dataHandler->AddFile("Light.esl", 0, true, 0x003);
+
+                Forms result;
+                result.sword = dataHandler->AddForm(0x00012EB7, skyrim, "Iron Sword");
+                result.boots = dataHandler->AddForm(0x02003A3E, dawnguard, "Fine Boots");
+                result.shout = dataHandler->AddForm(0xFE003801, light, "Unrelenting Force");
+                result.brew = dataHandler->AddForm(0xFF000800, nullptr, "Custom Brew");
+                return result;
+            }();
+            return forms;
+        }
+    };
+
+    // The format has no escaping: a string field reads back only if it holds no delimiter and does not end in
+    // ";##", which would run into the delimiter after it.
+    bool IsPackable(std::string_view _value) {
+        return _value.find(Utility::delimiter) == std::string_view::npos &&
+               !_value.ends_with(Utility::delimiter.substr(0, Utility::delimiter.size() - 1));
+    }
+
+    template <class T>
+    T UnpackResolved(std::string_view _packed) {
+        T result;
+        FormResolver resolver;
+        T::Unpack(_packed, result, &resolver);
+        resolver.Resolve();
+        return result;
+    }
+}
+
+// Strings as the Split-based Pack wrote them before Codec; both directions must still match them byte for byte.
+TEST_CASE(LegacyWeaponString) {
+    const auto& forms = Forms::Get();
+    constexpr auto packed = "2;##;Iron Sword;##;0;##;_ENCHNONE_;##;0.000000;##;77495;##;Skyrim.esm;##;"sv;
+    DataWeapon expected(DATATYPE::WEAP, "Iron Sword", 0, "_ENCHNONE_", 0.0f, forms.sword);
+
+    CHECK(DataWeapon::Unpack(packed) == expected);
+    CHECK(UnpackResolved<DataWeapon>(packed) == expected);
+    CHECK_EQ(expected.Pack(), packed);
+}
+
+TEST_CASE(LegacyArmorString) {
+    const auto& forms = Forms::Get();
+    constexpr auto packed = "5;##;Fine Boots;##;1;##;Boots of Strength;##;1.500000;##;14910;##;Dawnguard.esm;##;"sv;
+    DataArmor expected(DATATYPE::ARMOR, "Fine Boots", 1, "Boots of Strength", 1.5f, forms.boots);
+
+    CHECK(DataArmor::Unpack(packed) == expected);
+    CHECK(UnpackResolved<DataArmor>(packed) == expected);
+    CHECK_EQ(expected.Pack(), packed);
+}
+
+TEST_CASE(LegacyShoutStringFromLightPlugin) {
+    const auto& forms = Forms::Get();
+    constexpr auto packed = "4;##;Unrelenting Force;##;2049;##;Light.esl;##;"sv;
+    DataShout expected(DATATYPE::SHOUT, "Unrelenting Force", forms.shout);
+
+    CHECK(DataShout::Unpack(packed) == expected);
+    CHECK(UnpackResolved<DataShout>(packed) == expected);
+    CHECK_EQ(expected.Pack(), packed);
+}
+
+TEST_CASE(LegacyDynamicPotionString) {
+    const auto& forms = Forms::Get();
+    constexpr auto packed = "6;##;Custom Brew;##;4278192128;##;;##;"sv;
+    DataPotion expected(DATATYPE::POTION, "Custom Brew", forms.brew);
+
+    CHECK(DataPotion::Unpack(packed) == expected);
+    CHECK(UnpackResolved<DataPotion>(packed) == expected);
+    CHECK_EQ(expected.Pack(), packed);
+}
+
+TEST_CASE(LegacyEmptySlotString) {
+    constexpr auto packed = "0;##;_NOTHING;##;0;##;_ENCHNONE_;##;0.000000;##;0;##;;##;"sv;
+    DataWeapon expected(DATATYPE::NOTHING, "_NOTHING", 0, "_ENCHNONE_", 0.0f, nullptr);
+
+    CHECK(DataWeapon::Unpack(packed) == expected);
+    CHECK_EQ(expected.Pack(), packed);
+}
+
+TEST_CASE(LegacyWidgetStrings) {
+    constexpr auto iconPacked = "1;##;_BACKGROUND;##;-10;##;25;##;"sv;
+    auto icon = WidgetIcon::Unpack(iconPacked);
+    CHECK(icon.enable);
+    CHECK_EQ(icon.type, "_BACKGROUND");
+    CHECK_EQ(icon.offsetX, -10);
+    CHECK_EQ(icon.offsetY, 25);
+    CHECK_EQ(icon.Pack(), iconPacked);
+
+    constexpr auto textPacked = "0;##;2;##;0;##;-5;##;"sv;
+    auto text = WidgetText::Unpack(textPacked);
+    CHECK(!text.enable);
+    CHECK_EQ(text.align, WidgetText::ALIGN_TYPE::CENTER);
+    CHECK_EQ(text.offsetX, 0);
+    CHECK_EQ(text.offsetY, -5);
+    CHECK_EQ(text.Pack(), textPacked);
+}
+
+TEST_CASE(MissingTrailingDelimiterIsAccepted) {
+    const auto& forms = Forms::Get();
+    DataWeapon expected(DATATYPE::WEAP, "Iron Sword", 0, "_ENCHNONE_", 0.0f, forms.sword);
+
+    auto result = DataWeapon::Unpack("2;##;Iron Sword;##;0;##;_ENCHNONE_;##;0.000000;##;77495;##;Skyrim.esm");
+    CHECK(result == expected);
+}
+
+TEST_CASE(UnloadedPluginLeavesFormEmpty) {
+    auto result = UnpackResolved<DataArmor>("5;##;Boots;##;0;##;_ENCHNONE_;##;0.000000;##;14910;##;Missing.esp;##;");
+
+    CHECK_EQ(result.name, "Boots");
+    CHECK(result.form == nullptr);
+}
+
+TEST_CASE(MalformedStringsKeepDefaults) {
+    auto badType = DataWeapon::Unpack("x;##;Iron Sword;##;0;##;_ENCHNONE_;##;0.000000;##;77495;##;Skyrim.esm;##;");
+    CHECK_EQ(badType.type, DATATYPE::NOTHING);
+    CHECK_EQ(badType.enchName, "_ENCHNONE_");
+
+    auto truncated = DataArmor::Unpack("5;##;Fine Boots");
+    CHECK_EQ(truncated.type, DATATYPE::ARMOR);
+    CHECK_EQ(truncated.name, "Fine Boots");
+    CHECK_EQ(truncated.enchNum, 0U);
+    CHECK(truncated.form == nullptr);
+
+    auto badOffset = WidgetIcon::Unpack("1;##;_BACKGROUND;##;left;##;25;##;");
+    CHECK_EQ(badOffset.offsetX, 0);
+    CHECK_EQ(badOffset.offsetY, 0);
+
+    auto empty = DataPotion::Unpack("");
+    CHECK_EQ(empty.type, DATATYPE::NOTHING);
+}
+
+// Random records survive Pack and Unpack unchanged.
+TEST_CASE(FuzzRoundTrip) {
+    const auto& forms = Forms::Get();
+    const std::array<RE::TESForm*, 4> staticForms{nullptr, forms.sword, forms.boots, forms.shout};
+    const std::array<RE::TESForm*, 5> potionForms{nullptr, forms.sword, forms.boots, forms.shout, forms.brew};
+    constexpr std::string_view alphabet{"abcXYZ019 ;#-_.\xC3\xA9\xE4\xB8\xAD"};
+
+    std::mt19937 random(1234U);
+    auto RandomString = [&]() {
+        std::string result;
+        auto length = random() % 24U;
+        for (uint32_t i = 0; i < length; i++) result += alphabet[random() % alphabet.size()];
+        return result;
+    };
+    auto RandomType = [&]() { return static_cast<DATATYPE>(random() % 9U); };
+
+    for (uint32_t i = 0; i < 20000U; i++) {
+        auto name = RandomString();
+        auto enchName = RandomString();
+        if (!IsPackable(name) || !IsPackable(enchName)) continue;
+
+        // Sixty-fourths print exactly with six decimals.
+        auto tempVal = static_cast<float>(static_cast<int32_t>(random() % 20000U) - 10000) / 64.0f;
+        auto form = staticForms[random() % staticForms.size()];
+
+        DataArmor armor(RandomType(), name, random(), enchName, tempVal, form);
+        auto packed = armor.Pack();
+        REQUIRE(DataArmor::Unpack(packed) == armor);
+        REQUIRE(UnpackResolved<DataArmor>(packed) == armor);
+
+        DataPotion potion(RandomType(), name, potionForms[random() % potionForms.size()]);
+        REQUIRE(UnpackResolved<DataPotion>(potion.Pack()) == potion);
+
+        WidgetIcon icon;
+        icon.enable = random() % 2U;
+        icon.type = name;
+        icon.offsetX = static_cast<int>(random() % 4000U) - 2000;
+        icon.offsetY = static_cast<int>(random() % 4000U) - 2000;
+        auto iconBack = WidgetIcon::Unpack(icon.Pack());
+        REQUIRE(iconBack.enable == icon.enable && iconBack.type == icon.type && iconBack.offsetX == icon.offsetX &&
+                iconBack.offsetY == icon.offsetY);
+    }
+}
+
+// Damaged strings never crash the decoder, and whatever it decodes packs into a string that decodes to itself.
+// Packed text is compared rather than values, since a damaged number may read back as NaN.
+TEST_CASE(FuzzMutatedStrings) {
+    const auto& forms = Forms::Get();
+    const std::vector<std::string> seeds{
+        DataWeapon(DATATYPE::WEAP, "Iron Sword", 0, "_ENCHNONE_", 0.0f, forms.sword).Pack(),
+        DataArmor(DATATYPE::ARMOR, "Fine Boots", 1, "Boots of Strength", 1.5f, forms.boots).Pack(),
+        DataShout(DATATYPE::SHOUT, "Unrelenting Force", forms.shout).Pack(),
+        DataPotion(DATATYPE::POTION, "Custom Brew", forms.brew).Pack(),
+        "1;##;_BACKGROUND;##;-10;##;25;##;"};
+    constexpr std::string_view pieces[]{";##;", ";#", "#", "-", "+", "4294967296", "99999999999999999999", "1e39",
+                                        "nan", "\xFF", ""};
+
+    logger::ScopedMute mute;
+    std::mt19937 random(5678U);
+    for (uint32_t i = 0; i < 50000U; i++) {
+        auto packed = seeds[random() % seeds.size()];
+        auto mutations = 1U + random() % 4U;
+        for (uint32_t j = 0; j < mutations; j++) {
+            auto at = packed.empty() ? 0U : random() % (packed.size() + 1U);
+            switch (random() % 4U) {
+                case 0:
+                    packed.insert(at, pieces[random() % std::size(pieces)]);
+                    break;
+                case 1:
+                    packed.erase(at, random() % 8U);
+                    break;
+                case 2:
+                    if (at < packed.size()) packed[at] = static_cast<char>(random());
+                    break;
+                default:
+                    packed.resize(at);
+                    break;
+            }
+        }
+
+        auto weapon = UnpackResolved<DataWeapon>(packed);
+        if (IsPackable(weapon.name) && IsPackable(weapon.enchName)) {
+            auto repacked = weapon.Pack();
+            REQUIRE_EQ(UnpackResolved<DataWeapon>(repacked).Pack(), repacked);
+        }
+
+        auto potion = UnpackResolved<DataPotion>(packed);
+        if (IsPackable(potion.name)) {
+            auto repacked = potion.Pack();
+            REQUIRE_EQ(UnpackResolved<DataPotion>(repacked).Pack(), repacked);
+        }
+
+        auto text = WidgetText::Unpack(packed).Pack();
+        REQUIRE_EQ(WidgetText::Unpack(text).Pack(), text);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "Compression.h"
+
+#include "Harness.h"
+
+namespace {
+    using Bytes = std::vector<uint8_t>;
+
+    Bytes FromText(std::string_view _text) { return Bytes(_text.begin(), _text.end()); }
+
+    Bytes Random(std::mt19937& _random, size_t _size) {
+        Bytes result(_size);
+        for (auto& byte : result) byte = static_cast<uint8_t>(_random());
+        return result;
+    }
+
+    // Random runs, repeats at random distances and noise, so every sequence kind shows up.
+    Bytes Mixed(std::mt19937& _random, size_t _size) {
+        Bytes result;
+        result.reserve(_size);
+        while (result.size() < _size) {
+            auto length = std::min<size_t>(_size - result.size(), 1U + _random() % 600U);
+            switch (_random() % 3U) {
+                case 0:
+                    result.insert(result.end(), length, static_cast<uint8_t>(_random()));
+                    break;
+                case 1:
+                    if (!result.empty()) {
+                        auto from = _random() % result.size();
+                        for (size_t i = 0; i < length; i++) result.push_back(result[from + i]);
+                        break;
+                    }
+                    [[fallthrough]];
+                default:
+                    for (size_t i = 0; i < length; i++) result.push_back(static_cast<uint8_t>(_random() % 4U));
+                    break;
+            }
+        }
+        return result;
+    }
+
+    bool RoundTrips(const Bytes& _data) {
+        auto packed = Compression::Compress(_data);
+        Bytes unpacked;
+        return Compression::Decompress(packed, _data.size(), unpacked) && unpacked == _data;
+    }
+}
+
+TEST_CASE(RoundTripSmallInputs) {
+    CHECK(RoundTrips({}));
+    CHECK(RoundTrips({0x42}));
+    CHECK(RoundTrips(FromText("abc")));
+    CHECK(RoundTrips(FromText("abcd")));
+    CHECK(RoundTrips(FromText("abcdabcd")));
+}
+
+TEST_CASE(RoundTripLengthBoundaries) {
+    std::mt19937 random(1U);
+
+    // Literal and match lengths around the nibble limit and the 255 steps of the length extension.
+    for (size_t length : {14U, 15U, 16U, 269U, 270U, 271U, 524U, 525U, 526U}) {
+        auto literals = Random(random, length);
+        CHECK(RoundTrips(literals));
+
+        Bytes match(4, 0x11);
+        match.insert(match.end(), length + 4, 0x22);
+        match.insert(match.end(), literals.begin(), literals.end());
+        CHECK(RoundTrips(match));
+    }
+}
+
+TEST_CASE(RoundTripOverlappingMatch) {
+    Bytes data = FromText("ab");
+    for (int i = 0; i < 1000; i++) data.push_back(data[data.size() - 2]);
+
+    auto packed = Compression::Compress(data);
+    CHECK(packed.size() < 32U);
+    CHECK(RoundTrips(data));
+}
+
+TEST_CASE(RoundTripLargeInputs) {
+    std::mt19937 random(2U);
+
+    Bytes zeros(1U << 20, 0);
+    CHECK(Compression::Compress(zeros).size() < 8192U);
+    CHECK(RoundTrips(zeros));
+
+    // Incompressible data only grows by the literal length bytes.
+    auto noise = Random(random, 200000U);
+    CHECK(Compression::Compress(noise).size() <= noise.size() + noise.size() / 255U + 16U);
+    CHECK(RoundTrips(noise));
+
+    // Repeats further back than a 16-bit offset reaches have to be sent as literals again.
+    auto block = Random(random, 70000U);
+    Bytes far = block;
+    far.insert(far.end(), block.begin(), block.end());
+    CHECK(RoundTrips(far));
+}
+
+TEST_CASE(FuzzRoundTrip) {
+    std::mt19937 random(3U);
+    for (uint32_t i = 0; i < 2000U; i++) {
+        auto data = Mixed(random, random() % 20000U);
+        REQUIRE(RoundTrips(data));
+    }
+}
+
+TEST_CASE(RejectsWrongSize) {
+    auto data = FromText("the quick brown fox jumps over the quick brown dog");
+    auto packed = Compression::Compress(data);
+
+    Bytes out;
+    CHECK(!Compression::Decompress(packed, data.size() - 1, out));
+    CHECK(!Compression::Decompress(packed, data.size() + 1, out));
+    CHECK(!Compression::Decompress(packed, 0, out));
+}
+
+TEST_CASE(RejectsMalformedSequences) {
+    Bytes out;
+
+    // Literal length past the end of the input.
+    CHECK(!Compression::Decompress(Bytes{0x30, 'a', 'b'}, 3, out));
+    // Literal length extension that never ends.
+    CHECK(!Compression::Decompress(Bytes{0xF0, 255, 255}, 600, out));
+    // Match with a zero offset, and one reaching before the start of the output.
+    CHECK(!Compression::Decompress(Bytes{0x10, 'a', 0x00, 0x00, 0x00}, 5, out));
+    CHECK(!Compression::Decompress(Bytes{0x10, 'a', 0x02, 0x00, 0x00}, 5, out));
+    // Offset cut short.
+    CHECK(!Compression::Decompress(Bytes{0x10, 'a', 0x01}, 5, out));
+    // Match length extension cut short.
+    CHECK(!Compression::Decompress(Bytes{0x1F, 'a', 0x01, 0x00, 255}, 300, out));
+    // Match longer than the promised size.
+    CHECK(!Compression::Decompress(Bytes{0x10, 'a', 0x01, 0x00, 0x00}, 4, out));
+
+    // The same shapes, well formed.
+    CHECK(Compression::Decompress(Bytes{0x10, 'a', 0x01, 0x00, 0x00}, 5, out));
+    CHECK_EQ(out, FromText("aaaaa"));
+}
+
+// Every cut of a valid stream fails, unless the bytes cut off decoded to nothing.
+TEST_CASE(RejectsTruncatedStreams) {
+    std::mt19937 random(4U);
+    for (uint32_t i = 0; i < 50U; i++) {
+        auto data = Mixed(random, 1U + random() % 4000U);
+        auto packed = Compression::Compress(data);
+
+        for (size_t cut = 0; cut < packed.size(); cut++) {
+            Bytes out;
+            auto isDecoded = Compression::Decompress(std::span(packed).first(cut), data.size(), out);
+            REQUIRE(!isDecoded || out == data);
+        }
+    }
+}
+
+// Damaged streams never read or write out of bounds, and never report more or fewer bytes than promised.
+TEST_CASE(FuzzCorruptStreams) {
+    std::mt19937 random(5U);
+    for (uint32_t i = 0; i < 20000U; i++) {
+        auto data = Mixed(random, 1U + random() % 2000U);
+        auto packed = Compression::Compress(data);
+
+        auto flips = 1U + random() % 4U;
+        for (uint32_t j = 0; j < flips; j++) {
+            packed[random() % packed.size()] ^= static_cast<uint8_t>(1U << (random() % 8U));
+        }
+
+        Bytes out;
+        if (Compression::Decompress(packed, data.size(), out)) REQUIRE_EQ(out.size(), data.size());
+
+        // Pure noise as input.
+        auto noise = Random(random, random() % 64U);
+        if (Compression::Decompress(noise, 256U, out)) REQUIRE_EQ(out.size(), 256U);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "Equipset.h"
+#include "EquipsetManager.h"
+
+#include "Harness.h"
+
+namespace {
+    // Fills the fields both assignments must carry: the common ones, a pending payload and its widget hint.
+    void FillPending(Equipset& _equipset, Equipset::TYPE _type) {
+        _equipset.type = _type;
+        _equipset.name = "Pending";
+        _equipset.hotkey = 30U;
+        _equipset.modifier2 = true;
+        _equipset.gesture = Equipset::GESTURE::HOLD;
+        _equipset.leader = 42U;
+        _equipset.layer = 2U;
+        _equipset.padMask = 0x1000U;
+        _equipset.payload = 0x0123456789ABCDEFULL;
+        _equipset.isWidgetVisible = true;
+    }
+
+    void CheckCommon(const Equipset& _copied, const Equipset& _moved) {
+        CHECK(_copied.type == _moved.type);
+        CHECK_EQ(_copied.name, _moved.name);
+        CHECK_EQ(_copied.hotkey, _moved.hotkey);
+        CHECK_EQ(_copied.modifier2, _moved.modifier2);
+        CHECK(_copied.gesture == _moved.gesture);
+        CHECK_EQ(_copied.leader, _moved.leader);
+        CHECK_EQ(_copied.layer, _moved.layer);
+        CHECK_EQ(_copied.padMask, _moved.padMask);
+        CHECK_EQ(_copied.payload, _moved.payload);
+        CHECK_EQ(_copied.isWidgetVisible, _moved.isWidgetVisible);
+        CHECK_EQ(_copied.payload, 0x0123456789ABCDEFULL);
+        CHECK(_copied.isWidgetVisible);
+    }
+
+    void CreateBound(const std::string& _name, const uint32_t& _hotkey, const uint32_t& _padMask,
+                     Equipset::GESTURE _gesture = Equipset::GESTURE::PRESS, const uint32_t& _layer = 0U) {
+        NormalSet equipset;
+        equipset.type = Equipset::TYPE::NORMAL;
+        equipset.name = _name;
+        equipset.hotkey = _hotkey;
+        equipset.padMask = _padMask;
+        equipset.gesture = _gesture;
+        equipset.layer = _layer;
+        EquipsetManager::GetSingleton()->Create(std::move(equipset), true);
+    }
+}
+
+// A copy of a set that was never used keeps its payload, so it still materializes.
+TEST_CASE(NormalSetCopyMatchesMove) {
+    NormalSet source;
+    FillPending(source, Equipset::TYPE::NORMAL);
+    source.reEquip = true;
+    source.items.resize(2);
+
+    NormalSet copied;
+    copied = source;
+    NormalSet moved;
+    moved = std::move(source);
+
+    CheckCommon(copied, moved);
+    CHECK_EQ(copied.reEquip, moved.reEquip);
+    CHECK_EQ(copied.items.size(), moved.items.size());
+}
+
+TEST_CASE(PotionSetCopyMatchesMove) {
+    PotionSet source;
+    FillPending(source, Equipset::TYPE::POTION);
+    source.calcDuration = true;
+    source.items.resize(3);
+
+    PotionSet copied;
+    copied = source;
+    PotionSet moved;
+    moved = std::move(source);
+
+    CheckCommon(copied, moved);
+    CHECK_EQ(copied.calcDuration, moved.calcDuration);
+    CHECK_EQ(copied.items.size(), moved.items.size());
+}
+
+// The cycle position travels too, so a copied cycle resumes where its source was.
+TEST_CASE(CycleSetCopyMatchesMove) {
+    CycleSet source;
+    FillPending(source, Equipset::TYPE::CYCLE);
+    source.cyclePersist = true;
+    source.items = {"First", "Second", "Third"};
+    source.cycleIndex = 2U;
+    source.isCycleInit = true;
+
+    CycleSet copied;
+    copied = source;
+    CycleSet moved;
+    moved = std::move(source);
+
+    CheckCommon(copied, moved);
+    CHECK_EQ(copied.cyclePersist, moved.cyclePersist);
+    CHECK_EQ(copied.items, moved.items);
+    CHECK_EQ(copied.cycleIndex, moved.cycleIndex);
+    CHECK_EQ(copied.cycleIndex, 2U);
+    CHECK_EQ(copied.isCycleInit, moved.isCycleInit);
+    CHECK(copied.isCycleInit);
+}
+
+// Removing a bound set hands its chord to the set left unbound on it, and its pad buttons leave the mask only
+// once no set needs them.
+TEST_CASE(RemovedChordPassesToUnboundSet) {
+    auto manager = EquipsetManager::GetSingleton();
+    manager->RemoveAll();
+    logger::ScopedMute mute;
+
+    CreateBound("First", 30U, 0x3U);
+    CreateBound("Second", 30U, 0x3U);
+    CreateBound("Third", 31U, 0x1U);
+    auto first = manager->SearchEquipsetByName("First");
+    auto second = manager->SearchEquipsetByName("Second");
+    auto third = manager->SearchEquipsetByName("Third");
+    REQUIRE(first && second && third);
+    CHECK(manager->SearchEquipsetByChord(30U, false, false, false, Equipset::GESTURE::PRESS, 0U, 0U, 0x3U) == first);
+    CHECK_EQ(manager->GetPadChordMask(), 0x3U);
+
+    manager->Remove(first);
+    CHECK(manager->SearchEquipsetByChord(30U, false, false, false, Equipset::GESTURE::PRESS, 0U, 0U, 0x3U) == second);
+    CHECK_EQ(manager->GetPadChordMask(), 0x3U);
+
+    manager->Remove(second);
+    CHECK(manager->SearchEquipsetByChord(30U, false, false, false, Equipset::GESTURE::PRESS, 0U, 0U, 0x3U) == nullptr);
+    CHECK_EQ(manager->GetPadChordMask(), 0x1U);
+
+    manager->SetChord(third, 31U, false, false, false, Equipset::GESTURE::PRESS, 0U, 1U, 0U);
+    CHECK_EQ(manager->GetPadChordMask(), 0U);
+    CHECK(manager->SearchEquipsetByChord(31U, false, false, false, Equipset::GESTURE::PRESS, 0U, 1U, 0U) == third);
+
+    manager->RemoveAll();
+}
+
+// Only keys the active layer binds a hold to ask the input sink for held repeats.
+TEST_CASE(HoldKeysFollowActiveLayer) {
+    auto manager = EquipsetManager::GetSingleton();
+    manager->RemoveAll();
+    logger::ScopedMute mute;
+
+    CreateBound("Tap", 30U, 0U);
+    CreateBound("Hold", 31U, 0U, Equipset::GESTURE::HOLD);
+    CreateBound("Other", 32U, 0U, Equipset::GESTURE::HOLD, 1U);
+    CHECK(!manager->IsHoldKey(30U));
+    CHECK(manager->IsHoldKey(31U));
+    CHECK(!manager->IsHoldKey(32U));
+
+    manager->SetActiveLayer(1U);
+    CHECK(!manager->IsHoldKey(31U));
+    CHECK(manager->IsHoldKey(32U));
+
+    manager->Remove(manager->SearchEquipsetByName("Other"));
+    CHECK(!manager->IsHoldKey(32U));
+
+    manager->SetActiveLayer(0U);
+    CHECK(manager->IsHoldKey(31U));
+
+    manager->RemoveAll();
+    CHECK(!manager->IsHoldKey(31U));
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "ExtraData.h"
+
+#include "Harness.h"
+
+namespace {
+    // A tempered copy of _weapon in the player's inventory, as the game would list it.
+    RE::ExtraDataList* AddTempered(RE::TESObjectWEAP* _weapon, float _health) {
+        auto xList = RE::PlayerCharacter::GetSingleton()->AddExtraList(_weapon);
+        xList->Add<RE::ExtraHealth>()->health = _health;
+        return xList;
+    }
+}
+
+// After an equip call the index hands out the list the inventory holds now, not the one it cached.
+TEST_CASE(InvalidatedIndexRefetchesLists) {
+    auto dataHandler = RE::TESDataHandler::GetSingleton();
+    auto player = RE::PlayerCharacter::GetSingleton();
+    auto weapon = dataHandler->AddForm<RE::TESObjectWEAP>(0x01000800U, nullptr, "Sword");
+    player->AddObjectToContainer(weapon, 1);
+    auto cached = AddTempered(weapon, 1.5f);
+
+    Extra::ExtraDataIndex index;
+    index.Build({weapon});
+    CHECK(index.Search(weapon, 0U, Extra::ENCHNONE, 1.5f) == cached);
+
+    // The game merges the stack into a new list and frees the old one.
+    auto& stack = player->container[weapon];
+    stack.extraLists.clear();
+    auto merged = AddTempered(weapon, 1.5f);
+
+    index.Invalidate();
+    CHECK(index.Search(weapon, 0U, Extra::ENCHNONE, 1.5f) == merged);
+
+    // An item that left the inventory is not found, whatever was cached for it.
+    player->container.erase(weapon);
+    index.Invalidate();
+    CHECK(index.Search(weapon, 0U, Extra::ENCHNONE, 1.5f) == nullptr);
+
+    dataHandler->Clear();
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "FileWriter.h"
+
+#include "Harness.h"
+
+namespace {
+    // Passes through to the real file system and records the calls, failing the step a test asks for.
+    class RecordingApi : public FileApi {
+    public:
+        class RecordingFile : public File {
+        public:
+            RecordingFile(RecordingApi& _api, std::unique_ptr<File> _file) : api(_api), file(std::move(_file)) {}
+            ~RecordingFile() override { api.calls.push_back("close"); }
+
+            bool Write(const char* _data, size_t _size) override {
+                api.calls.push_back("write");
+                api.writeSizes.push_back(_size);
+                if (api.failWrite && api.writeSizes.size() > 1) return false;
+                return file->Write(_data, _size);
+            }
+
+            bool Sync() override {
+                api.calls.push_back("sync");
+                return !api.failSync && file->Sync();
+            }
+
+        private:
+            RecordingApi& api;
+            std::unique_ptr<File> file;
+        };
+
+        std::unique_ptr<File> Create(const std::filesystem::path& _path) override {
+            calls.push_back("create");
+            if (failCreate) return nullptr;
+
+            auto file = FileApi::GetNative()->Create(_path);
+            if (!file) return nullptr;
+            return std::make_unique<RecordingFile>(*this, std::move(file));
+        }
+
+        bool Replace(const std::filesystem::path& _from, const std::filesystem::path& _to) override {
+            calls.push_back("replace");
+            return !failReplace && FileApi::GetNative()->Replace(_from, _to);
+        }
+
+        void Remove(const std::filesystem::path& _path) override {
+            calls.push_back("remove");
+            FileApi::GetNative()->Remove(_path);
+        }
+
+        std::vector<std::string> calls;
+        std::vector<size_t> writeSizes;
+        bool failCreate{false};
+        bool failWrite{false};  // fails every write after the first
+        bool failSync{false};
+        bool failReplace{false};
+    };
+
+    // Points FileWriter at a fresh directory through a RecordingApi for the length of one test.
+    class Fixture {
+    public:
+        Fixture() {
+            dir = std::filesystem::temp_directory_path() / ("uihs_filewriter_" + Harness::GetCurrentName());
+            std::filesystem::remove_all(dir);
+            std::filesystem::create_directories(dir);
+            path = dir / "Equipset.toml";
+            temp = dir / "Equipset.toml.tmp";
+
+            FileWriter::GetSingleton()->SetFileApi(&api);
+        }
+
+        ~Fixture() {
+            FileWriter::GetSingleton()->Flush();
+            FileWriter::GetSingleton()->SetFileApi(FileApi::GetNative());
+            std::filesystem::remove_all(dir);
+        }
+
+        // Writes _contents through FileWriter and returns whether the write reported success.
+        bool Write(std::string _contents) {
+            std::optional<bool> result;
+            FileWriter::GetSingleton()->Write(path, std::move(_contents), [&](bool _ok) { result = _ok; });
+            FileWriter::GetSingleton()->Flush();
+            CHECK(result.has_value());
+            return result.value_or(false);
+        }
+
+        std::string ReadBack() const {
+            std::ifstream file(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        RecordingApi api;
+        std::filesystem::path dir;
+        std::filesystem::path path;
+        std::filesystem::path temp;
+    };
+
+    using Calls = std::vector<std::string>;
+
+    // Larger than the writer's chunk, so the encoder output reaches the file in several writes.
+    std::string MakeContents(char _fill) { return std::string(200 * 1024 + 17, _fill); }
+}
+
+TEST_CASE(PublishesThroughTempFileAfterSync) {
+    Fixture f;
+    REQUIRE(f.Write("new"));
+
+    CHECK_EQ(f.ReadBack(), "new");
+    CHECK(!std::filesystem::exists(f.temp));
+    CHECK_EQ(f.api.calls, (Calls{"create", "write", "sync", "close", "replace"}));
+}
+
+TEST_CASE(StreamsEncoderOutputInChunks) {
+    Fixture f;
+    auto contents = MakeContents('a');
+    REQUIRE(f.Write(contents));
+
+    CHECK_EQ(f.ReadBack(), contents);
+    REQUIRE(f.api.writeSizes.size() > 1U);
+    for (auto size : f.api.writeSizes) {
+        CHECK(size <= 64U * 1024U);
+    }
+}
+
+TEST_CASE(ReplacesExistingFile) {
+    Fixture f;
+    REQUIRE(f.Write(MakeContents('a')));
+    REQUIRE(f.Write("short"));
+
+    CHECK_EQ(f.ReadBack(), "short");
+    CHECK(!std::filesystem::exists(f.temp));
+}
+
+TEST_CASE(FailedCreateKeepsOldFile) {
+    Fixture f;
+    REQUIRE(f.Write("old"));
+    f.api.failCreate = true;
+
+    CHECK(!f.Write("new"));
+    CHECK_EQ(f.ReadBack(), "old");
+    CHECK(!std::filesystem::exists(f.temp));
+}
+
+TEST_CASE(FailedWriteKeepsOldFileAndRemovesTemp) {
+    Fixture f;
+    REQUIRE(f.Write("old"));
+    f.api.calls.clear();
+    f.api.writeSizes.clear();
+    f.api.failWrite = true;
+
+    CHECK(!f.Write(MakeContents('b')));
+    CHECK_EQ(f.ReadBack(), "old");
+    CHECK(!std::filesystem::exists(f.temp));
+    CHECK_EQ(std::ranges::count(f.api.calls, "replace"), 0);
+    CHECK_EQ(f.api.calls.back(), "remove");
+}
+
+TEST_CASE(FailedSyncNeverPublishes) {
+    Fixture f;
+    REQUIRE(f.Write("old"));
+    f.api.calls.clear();
+    f.api.failSync = true;
+
+    CHECK(!f.Write("new"));
+    CHECK_EQ(f.ReadBack(), "old");
+    CHECK(!std::filesystem::exists(f.temp));
+    CHECK_EQ(f.api.calls, (Calls{"create", "write", "sync", "close", "remove"}));
+}
+
+TEST_CASE(FailedReplaceKeepsOldFileAndRemovesTemp) {
+    Fixture f;
+    REQUIRE(f.Write("old"));
+    f.api.calls.clear();
+    f.api.failReplace = true;
+
+    CHECK(!f.Write("new"));
+    CHECK_EQ(f.ReadBack(), "old");
+    CHECK(!std::filesystem::exists(f.temp));
+    CHECK_EQ(f.api.calls, (Calls{"create", "write", "sync", "close", "replace", "remove"}));
+}
+
+TEST_CASE(CoalescedWriteReportsToEveryCaller) {
+    Fixture f;
+    auto writer = FileWriter::GetSingleton();
+
+    // Holds the writer thread inside the first job so the next two meet in the queue.
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    writer->Write(f.dir / "gate.toml", [gate](std::ostream& _stream) {
+        gate.wait();
+        _stream << "gate";
+    });
+
+    std::vector<bool> results;
+    std::mutex resultsLock;
+    auto record = [&](bool _ok) {
+        std::lock_guard<std::mutex> guard(resultsLock);
+        results.push_back(_ok);
+    };
+    writer->Write(f.path, "first"s, record);
+    writer->Write(f.path, "second"s, record);
+    release.set_value();
+    writer->Flush();
+
+    CHECK_EQ(f.ReadBack(), "second");
+    CHECK_EQ(results, (std::vector<bool>{true, true}));
+}
+
+TEST_CASE(ThrowingEncoderFailsEveryCallerAndRemovesTemp) {
+    Fixture f;
+    REQUIRE(f.Write("old"));
+    auto writer = FileWriter::GetSingleton();
+    logger::ScopedMute mute;
+
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    writer->Write(f.dir / "gate.toml", [gate](std::ostream& _stream) {
+        gate.wait();
+        _stream << "gate";
+    });
+
+    std::vector<bool> results;
+    std::mutex resultsLock;
+    auto record = [&](bool _ok) {
+        std::lock_guard<std::mutex> guard(resultsLock);
+        results.push_back(_ok);
+    };
+    writer->Write(f.path, "first"s, record);
+    writer->Write(
+        f.path,
+        [](std::ostream& _stream) {
+            _stream << MakeContents('b');
+            throw std::runtime_error("encoder failed");
+        },
+        record);
+    release.set_value();
+    writer->Flush();
+
+    CHECK_EQ(f.ReadBack(), "old");
+    CHECK(!std::filesystem::exists(f.temp));
+    CHECK_EQ(results, (std::vector<bool>{false, false}));
+
+    // The writer thread survives the exception.
+    CHECK(f.Write("new"));
+    CHECK_EQ(f.ReadBack(), "new");
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Harness.h"
+
+namespace {
+    struct Test {
+        const char* name;
+        Harness::TestFunc func;
+    };
+
+    std::vector<Test>& GetTests() {
+        static std::vector<Test> tests;
+        return tests;
+    }
+
+    const char* currentName{""};
+    bool isFailed{false};
+}
+
+namespace Harness {
+    int Register(const char* _name, TestFunc _func) {
+        GetTests().push_back({_name, _func});
+        return 0;
+    }
+
+    void Fail(const char* _file, int _line, const std::string& _message, bool _isFatal) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", _file, _line, _message.c_str());
+        isFailed = true;
+        if (_isFatal) throw Failure{_message};
+    }
+
+    std::string GetCurrentName() { return currentName; }
+}
+
+// Runs every registered test, or those whose name contains argv[1].
+int main(int _argc, char** _argv) {
+    std::string_view filter = _argc > 1 ? _argv[1] : "";
+
+    uint32_t failedCount = 0U;
+    uint32_t runCount = 0U;
+    for (const auto& test : GetTests()) {
+        if (std::string_view(test.name).find(filter) == std::string_view::npos) continue;
+
+        currentName = test.name;
+        isFailed = false;
+        try {
+            test.func();
+        } catch (const Harness::Failure&) {
+        } catch (const std::exception& _e) {
+            std::fprintf(stderr, "%s: unexpected exception: %s\n", test.name, _e.what());
+            isFailed = true;
+        }
+
+        ++runCount;
+        if (isFailed) ++failedCount;
+        std::printf("[%s] %s\n", isFailed ? "FAIL" : " OK ", test.name);
+    }
+
+    std::printf("%u of %u tests passed.\n", runCount - failedCount, runCount);
+    std::fflush(stdout);
+
+    // Singletons such as FileWriter keep a detached worker waiting on their members; like the game's own exit,
+    // leave without running static destructors under it.
+    std::_Exit(failedCount == 0U && runCount > 0U ? 0 : 1);
+}
\ No newline at end of file
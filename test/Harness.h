@@ -0,0 +1,64 @@
+#pragma once
+
+// Minimal test registry so the host tests need nothing beyond the standard library.
+namespace Harness {
+    struct Failure {
+        std::string message;
+    };
+
+    using TestFunc = void (*)();
+
+    int Register(const char* _name, TestFunc _func);
+    void Fail(const char* _file, int _line, const std::string& _message, bool _isFatal);
+    std::string GetCurrentName();
+
+    template <class T>
+    std::string Describe(const T& _value) {
+        if constexpr (requires(std::ostream& _stream) { _stream << _value; }) {
+            std::ostringstream stream;
+            stream << _value;
+            return stream.str();
+        } else if constexpr (std::ranges::range<T>) {
+            std::string result{"{"};
+            for (const auto& element : _value) {
+                if (result.size() > 1) result += ", ";
+                result += Describe(element);
+            }
+            return result + "}";
+        } else {
+            return "<value>";
+        }
+    }
+}
+
+#define HARNESS_CONCAT_(A, B) A##B
+#define HARNESS_CONCAT(A, B) HARNESS_CONCAT_(A, B)
+
+// Defines and registers a test; a CHECK failure marks it failed and carries on, a REQUIRE failure ends it.
+#define TEST_CASE(NAME)                                                                   \
+    static void HARNESS_CONCAT(Test_, NAME)();                                            \
+    static const int HARNESS_CONCAT(registered_, NAME) =                                  \
+        Harness::Register(#NAME, &HARNESS_CONCAT(Test_, NAME));                           \
+    static void HARNESS_CONCAT(Test_, NAME)()
+
+#define HARNESS_CHECK(EXPR, IS_FATAL)                                                     \
+    do {                                                                                  \
+        if (!(EXPR)) Harness::Fail(__FILE__, __LINE__, #EXPR, IS_FATAL);                  \
+    } while (false)
+
+#define HARNESS_CHECK_EQ(A, B, IS_FATAL)                                                  \
+    do {                                                                                  \
+        const auto& lhs_ = (A);                                                           \
+        const auto& rhs_ = (B);                                                           \
+        if (!(lhs_ == rhs_)) {                                                            \
+            Harness::Fail(__FILE__, __LINE__,                                             \
+                          #A " == " #B " (" + Harness::Describe(lhs_) + " vs " +          \
+                              Harness::Describe(rhs_) + ")",                              \
+                          IS_FATAL);                                                      \
+        }                                                                                 \
+    } while (false)
+
+#define CHECK(EXPR) HARNESS_CHECK(EXPR, false)
+#define REQUIRE(EXPR) HARNESS_CHECK(EXPR, true)
+#define CHECK_EQ(A, B) HARNESS_CHECK_EQ(A, B, false)
+#define REQUIRE_EQ(A, B) HARNESS_CHECK_EQ(A, B, true)
\ No newline at end of file
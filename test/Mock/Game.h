@@ -0,0 +1,522 @@
+#pragma once
+
+// The slice of CommonLibSSE the tested sources use, with the same names and signatures. Forms and plugins are
+// plain objects registered by the tests; the player, equip manager, UI and SKSE task queue are recording
+// stand-ins; everything else is a type the headers only need to name.
+namespace RE {
+    using FormID = uint32_t;
+
+    enum class FormType : uint8_t {
+        None = 0,
+        MagicEffect = 18,
+        Enchantment = 21,
+        Spell = 22,
+        Armor = 26,
+        Light = 31,
+        Weapon = 41,
+        AlchemyItem = 46,
+        LeveledItem = 53,
+        Reference = 61,
+        ActorCharacter = 62,
+        Shout = 119
+    };
+
+    class TESFile {
+    public:
+        std::string_view GetFilename() const { return fileName; }
+        bool IsLight() const { return isLight; }
+
+        std::string fileName;
+        uint8_t compileIndex{0xFF};
+        uint16_t smallFileCompileIndex{0};
+        bool isLight{false};
+    };
+
+    class TESForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::None;
+
+        virtual ~TESForm() = default;
+
+        TESFile* GetFile(int32_t _index = -1) const { return _index <= 0 ? file : nullptr; }
+        FormID GetFormID() const { return formID; }
+        FormID GetLocalFormID() const { return file && file->IsLight() ? formID & 0xFFFU : formID & 0xFFFFFFU; }
+        bool IsDynamicForm() const { return (formID >> 24) == 0xFF; }
+        const char* GetName() const { return name.c_str(); }
+        FormType GetFormType() const { return formType; }
+
+        template <class... Args>
+        bool Is(Args... _types) const {
+            return ((formType == _types) || ...);
+        }
+
+        template <class T>
+        T* As() {
+            return dynamic_cast<T*>(this);
+        }
+
+        template <class T>
+        const T* As() const {
+            return dynamic_cast<const T*>(this);
+        }
+
+        static TESForm* LookupByID(FormID _formID);
+
+        template <class T>
+        static T* LookupByID(FormID _formID) {
+            auto form = LookupByID(_formID);
+            return form ? form->As<T>() : nullptr;
+        }
+
+        FormID formID{0};
+        FormType formType{FormType::None};
+        TESFile* file{nullptr};
+        std::string name;
+    };
+
+    class TESBoundObject : public TESForm {};
+    class EffectSetting : public TESForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::MagicEffect;
+    };
+
+    class Effect {
+    public:
+        float GetMagnitude() const { return magnitude; }
+        uint32_t GetDuration() const { return duration; }
+
+        EffectSetting* baseEffect{nullptr};
+        float magnitude{0.0f};
+        uint32_t duration{0U};
+    };
+
+    class MagicItem : public TESBoundObject {
+    public:
+        std::vector<Effect*> effects;
+    };
+
+    class SpellItem : public MagicItem {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Spell;
+    };
+
+    class EnchantmentItem : public MagicItem {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Enchantment;
+    };
+
+    class AlchemyItem : public MagicItem {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::AlchemyItem;
+    };
+
+    class TESObjectWEAP : public TESBoundObject {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Weapon;
+
+        EnchantmentItem* formEnchanting{nullptr};
+    };
+
+    class TESObjectARMO : public TESBoundObject {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Armor;
+
+        bool IsShield() const { return isShield; }
+
+        EnchantmentItem* formEnchanting{nullptr};
+        bool isShield{false};
+    };
+
+    enum class ExtraDataType : uint8_t {
+        kHealth = 0x25,
+        kHotkey = 0x4A,
+        kEnchantment = 0x9B
+    };
+
+    class BSExtraData {
+    public:
+        virtual ~BSExtraData() = default;
+        virtual ExtraDataType GetType() const = 0;
+    };
+
+    class ExtraHealth : public BSExtraData {
+    public:
+        inline static constexpr auto EXTRADATATYPE = ExtraDataType::kHealth;
+        ExtraDataType GetType() const override { return EXTRADATATYPE; }
+
+        float health{1.0f};
+    };
+
+    class ExtraHotkey : public BSExtraData {
+    public:
+        inline static constexpr auto EXTRADATATYPE = ExtraDataType::kHotkey;
+        ExtraDataType GetType() const override { return EXTRADATATYPE; }
+    };
+
+    class ExtraEnchantment : public BSExtraData {
+    public:
+        inline static constexpr auto EXTRADATATYPE = ExtraDataType::kEnchantment;
+        ExtraDataType GetType() const override { return EXTRADATATYPE; }
+
+        EnchantmentItem* enchantment{nullptr};
+    };
+
+    class ExtraDataList {
+    public:
+        bool HasType(ExtraDataType _type) const { return Find(_type) != nullptr; }
+
+        template <class T>
+        bool HasType() const {
+            return HasType(T::EXTRADATATYPE);
+        }
+
+        template <class T>
+        const T* GetByType() const {
+            return static_cast<const T*>(Find(T::EXTRADATATYPE));
+        }
+
+        template <class T>
+        T* Add() {
+            auto& extra = data.emplace_back(std::make_unique<T>());
+            return static_cast<T*>(extra.get());
+        }
+
+        std::vector<std::unique_ptr<BSExtraData>> data;
+
+    private:
+        const BSExtraData* Find(ExtraDataType _type) const {
+            auto it = std::ranges::find_if(data, [_type](const auto& _extra) { return _extra->GetType() == _type; });
+            return it != data.end() ? it->get() : nullptr;
+        }
+    };
+
+    class InventoryEntryData {
+    public:
+        TESBoundObject* object{nullptr};
+        std::unique_ptr<std::vector<ExtraDataList*>> extraLists;
+    };
+
+    // Holds its stacks and their extra data lists; GetInventory copies them out the way the game builds the map.
+    class TESObjectREFR : public TESForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Reference;
+
+        using Count = int32_t;
+        using InventoryItemMap = std::map<TESBoundObject*, std::pair<Count, std::unique_ptr<InventoryEntryData>>>;
+
+        InventoryItemMap GetInventory(std::function<bool(TESBoundObject&)> _filter = [](TESBoundObject&) {
+            return true;
+        }) const {
+            InventoryItemMap result;
+            for (const auto& [object, stack] : container) {
+                if (!_filter(*object)) continue;
+
+                auto entry = std::make_unique<InventoryEntryData>();
+                entry->object = object;
+                if (!stack.extraLists.empty()) {
+                    entry->extraLists = std::make_unique<std::vector<ExtraDataList*>>();
+                    for (const auto& xList : stack.extraLists) {
+                        entry->extraLists->push_back(xList.get());
+                    }
+                }
+                result.emplace(object, std::make_pair(stack.count, std::move(entry)));
+            }
+            return result;
+        }
+
+        void AddObjectToContainer(TESBoundObject* _object, Count _count) { container[_object].count += _count; }
+
+        // A new extra data list on the object's stack, owned by the container.
+        ExtraDataList* AddExtraList(TESBoundObject* _object) {
+            return container[_object].extraLists.emplace_back(std::make_unique<ExtraDataList>()).get();
+        }
+
+        struct Stack {
+            Count count{0};
+            std::vector<std::unique_ptr<ExtraDataList>> extraLists;
+        };
+        std::map<TESBoundObject*, Stack> container;
+    };
+
+    // Owns every plugin and form a test registers.
+    class TESDataHandler {
+    public:
+        static TESDataHandler* GetSingleton() {
+            static TESDataHandler singleton;
+            return std::addressof(singleton);
+        }
+
+        const TESFile* LookupModByName(std::string_view _modName) {
+            auto it = std::ranges::find_if(files, [&](const auto& _file) { return _file->fileName == _modName; });
+            return it != files.end() ? it->get() : nullptr;
+        }
+
+        TESForm* LookupForm(FormID _localFormID, std::string_view _modName) {
+            auto file = LookupModByName(_modName);
+            if (!file || file->compileIndex == 0xFF) return nullptr;
+
+            auto id = file->IsLight() ? (0xFEU << 24) | (file->smallFileCompileIndex << 12) | (_localFormID & 0xFFFU)
+                                      : (static_cast<FormID>(file->compileIndex) << 24) | (_localFormID & 0xFFFFFFU);
+            return TESForm::LookupByID(id);
+        }
+
+        TESFile* AddFile(std::string_view _name, uint8_t _compileIndex, bool _isLight = false,
+                         uint16_t _smallFileCompileIndex = 0) {
+            auto& file = files.emplace_back(std::make_unique<TESFile>());
+            file->fileName = _name;
+            file->compileIndex = _isLight ? 0xFE : _compileIndex;
+            file->smallFileCompileIndex = _smallFileCompileIndex;
+            file->isLight = _isLight;
+            return file.get();
+        }
+
+        template <class T = TESForm>
+        T* AddForm(FormID _formID, TESFile* _file, std::string_view _name = {}) {
+            auto form = std::make_unique<T>();
+            form->formID = _formID;
+            form->formType = T::FORMTYPE;
+            form->file = _file;
+            form->name = _name;
+
+            auto result = form.get();
+            formMap[_formID] = std::move(form);
+            return result;
+        }
+
+        void Clear() {
+            formMap.clear();
+            files.clear();
+        }
+
+        std::vector<std::unique_ptr<TESFile>> files;
+        std::unordered_map<FormID, std::unique_ptr<TESForm>> formMap;
+    };
+
+    inline TESForm* TESForm::LookupByID(FormID _formID) {
+        auto& formMap = TESDataHandler::GetSingleton()->formMap;
+        auto it = formMap.find(_formID);
+        return it != formMap.end() ? it->second.get() : nullptr;
+    }
+
+    class BGSEquipSlot {};
+    class TESShout : public TESForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Shout;
+    };
+
+    class Actor : public TESObjectREFR {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::ActorCharacter;
+    };
+
+    // Holds whatever the mocked equip manager last put in each hand or on the body; the hand slots are its own.
+    class PlayerCharacter : public Actor {
+    public:
+        static PlayerCharacter* GetSingleton() {
+            static PlayerCharacter singleton;
+            return std::addressof(singleton);
+        }
+
+        TESForm* GetEquippedObject(bool _leftHand) const { return _leftHand ? leftHand : rightHand; }
+
+        BGSEquipSlot leftHandSlot;
+        BGSEquipSlot rightHandSlot;
+        TESForm* leftHand{nullptr};
+        TESForm* rightHand{nullptr};
+        TESShout* shout{nullptr};
+        std::set<TESForm*> worn;
+        std::vector<TESForm*> spells;  // spells and shouts the player knows
+    };
+
+    // Counts the calls instead of equipping anything; a weapon lands in the hand its slot names, anything
+    // equipped without a slot is worn.
+    class ActorEquipManager {
+    public:
+        static ActorEquipManager* GetSingleton() {
+            static ActorEquipManager singleton;
+            return std::addressof(singleton);
+        }
+
+        void EquipObject(Actor* _actor, TESBoundObject* _object, ExtraDataList* _extraData = nullptr,
+                         uint32_t _count = 1, const BGSEquipSlot* _slot = nullptr, bool _queueEquip = true,
+                         bool _forceEquip = false, bool _playSounds = true, bool _applyNow = false) {
+            ++equipCount;
+            auto player = PlayerCharacter::GetSingleton();
+            if (_actor != player) return;
+
+            if (_slot == &player->leftHandSlot) {
+                player->leftHand = _object;
+            } else if (_slot == &player->rightHandSlot) {
+                player->rightHand = _object;
+            } else {
+                player->worn.insert(_object);
+            }
+        }
+
+        void UnequipObject(Actor* _actor, TESBoundObject* _object, ExtraDataList* _extraData = nullptr,
+                           uint32_t _count = 1, const BGSEquipSlot* _slot = nullptr, bool _queueEquip = true,
+                           bool _forceEquip = false, bool _playSounds = true, bool _applyNow = false,
+                           const BGSEquipSlot* _slotToReplace = nullptr) {
+            ++unequipCount;
+            auto player = PlayerCharacter::GetSingleton();
+            if (_actor != player) return;
+
+            if (player->leftHand == _object) player->leftHand = nullptr;
+            if (player->rightHand == _object) player->rightHand = nullptr;
+            player->worn.erase(_object);
+        }
+
+        void EquipSpell(Actor* _actor, SpellItem* _spell, const BGSEquipSlot* _slot = nullptr) { ++equipCount; }
+
+        void EquipShout(Actor* _actor, TESShout* _shout) {
+            ++equipCount;
+            if (_actor == PlayerCharacter::GetSingleton()) PlayerCharacter::GetSingleton()->shout = _shout;
+        }
+
+        uint64_t equipCount{0U};
+        uint64_t unequipCount{0U};
+    };
+
+    class MagicFavorites {
+    public:
+        static MagicFavorites* GetSingleton() {
+            static MagicFavorites singleton;
+            return std::addressof(singleton);
+        }
+
+        std::vector<TESForm*> spells;
+    };
+
+    class UI {
+    public:
+        static UI* GetSingleton() {
+            static UI singleton;
+            return std::addressof(singleton);
+        }
+
+        bool GameIsPaused() const { return numPausesGame > 0; }
+
+        uint32_t numPausesGame{0};
+    };
+
+    enum class BSEventNotifyControl {
+        kContinue = 0,
+        kStop = 1
+    };
+
+    struct MenuOpenCloseEvent {
+        std::string menuName;
+        bool opening{false};
+    };
+
+    template <class Event>
+    class BSTEventSource {};
+
+    template <class Event>
+    class BSTEventSink {
+    public:
+        virtual ~BSTEventSink() = default;
+        virtual BSEventNotifyControl ProcessEvent(const Event* _event, BSTEventSource<Event>* _eventSource) = 0;
+    };
+}
+
+namespace SKSE {
+    // One record held in memory: writes append to data and reads consume it from the front.
+    class SerializationInterface {
+    public:
+        bool WriteRecordData(const void* _buf, uint32_t _length) const {
+            auto bytes = static_cast<const uint8_t*>(_buf);
+            data.insert(data.end(), bytes, bytes + _length);
+            return true;
+        }
+
+        uint32_t ReadRecordData(void* _buf, uint32_t _length) const {
+            auto length = static_cast<uint32_t>(std::min<size_t>(_length, data.size() - readPos));
+            std::memcpy(_buf, data.data() + readPos, length);
+            readPos += length;
+            return length;
+        }
+
+        mutable std::vector<uint8_t> data;
+        mutable size_t readPos{0};
+    };
+
+    // Holds tasks until the test runs them, as the game runs SKSE tasks once per frame.
+    class TaskInterface {
+    public:
+        void AddTask(std::function<void()> _task) {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(_task));
+        }
+
+        // Runs the tasks queued so far; tasks they queue wait for the next call. Returns how many ran.
+        size_t RunTasks() {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                running.swap(tasks);
+            }
+
+            for (auto& task : running) {
+                task();
+            }
+
+            auto count = running.size();
+            running.clear();
+            return count;
+        }
+
+    private:
+        std::mutex lock;
+        std::vector<std::function<void()>> tasks;
+        std::vector<std::function<void()>> running;
+    };
+
+    inline TaskInterface* GetTaskInterface() {
+        static TaskInterface singleton;
+        return std::addressof(singleton);
+    }
+}
+
+// Address library lookups, resolved to the mocked game functions instead of offsets into the executable.
+namespace REL {
+    class Module {
+    public:
+        static bool IsAE() { return true; }
+    };
+
+    class ID {
+    public:
+        explicit constexpr ID(uint64_t _id) : value(_id) {}
+        constexpr uint64_t id() const { return value; }
+
+    private:
+        uint64_t value;
+    };
+
+    namespace detail {
+        inline RE::BGSEquipSlot* GetLeftHandSlot() { return &RE::PlayerCharacter::GetSingleton()->leftHandSlot; }
+        inline RE::BGSEquipSlot* GetRightHandSlot() { return &RE::PlayerCharacter::GetSingleton()->rightHandSlot; }
+    }
+
+    template <class T>
+    class Relocation;
+
+    template <class R, class... Args>
+    class Relocation<R(Args...)> {
+    public:
+        explicit Relocation(ID _id) : func(Resolve(_id.id())) {}
+
+        R operator()(Args... _args) const { return func(_args...); }
+
+    private:
+        static R (*Resolve(uint64_t _id))(Args...) {
+            if constexpr (std::is_same_v<R, RE::BGSEquipSlot*> && sizeof...(Args) == 0) {
+                if (_id == 23150 || _id == 23607) return detail::GetLeftHandSlot;
+                if (_id == 23151 || _id == 23608) return detail::GetRightHandSlot;
+            }
+            throw std::out_of_range("unmocked address library ID");
+        }
+
+        R (*func)(Args...);
+    };
+}
\ No newline at end of file
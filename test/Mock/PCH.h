@@ -0,0 +1,136 @@
+#pragma once
+
+// Stands in for src/PCH.h in the host tests: the standard library, a stderr log, and only as much of the game
+// as the sources under test touch.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <random>
+#include <ostream>
+#include <set>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Game.h"
+
+using namespace std::literals;
+
+// MSVC intrinsic the record tags are built with.
+constexpr uint32_t _byteswap_ulong(uint32_t _value) { return std::byteswap(_value); }
+
+// The plugin log, printed to stderr. Each "{...}" placeholder takes the next argument as streamed; integers
+// also take a zero fill, a width and a hex type, as in "{:016X}".
+namespace logger {
+    namespace detail {
+        inline std::atomic<bool> isMuted{false};
+
+        inline void Append(std::ostringstream& _out, std::string_view& _format) {
+            _out << _format;
+            _format = {};
+        }
+
+        template <class T, class... Args>
+        void Append(std::ostringstream& _out, std::string_view& _format, const T& _value, const Args&... _args) {
+            auto begin = _format.find('{');
+            auto end = _format.find('}', begin);
+            if (begin == std::string_view::npos || end == std::string_view::npos) return Append(_out, _format);
+
+            _out << _format.substr(0, begin);
+            auto spec = _format.substr(begin + 1, end - begin - 1);
+            if (spec.starts_with(':')) spec.remove_prefix(1);
+            auto flags = _out.flags();
+            auto fill = _out.fill();
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                if (spec.starts_with('0')) _out.fill('0');
+                if (!spec.empty() && (spec.back() == 'X' || spec.back() == 'x')) {
+                    _out << std::hex << (spec.back() == 'X' ? std::uppercase : std::nouppercase);
+                    spec.remove_suffix(1);
+                }
+                uint32_t width = 0U;
+                std::from_chars(spec.data(), spec.data() + spec.size(), width);
+                _out.width(width);
+            }
+            if constexpr (std::is_same_v<T, bool>) {
+                _out << (_value ? "true" : "false");
+            } else if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+                _out << static_cast<int>(_value);
+            } else {
+                _out << _value;
+            }
+            _out.flags(flags);
+            _out.fill(fill);
+            _format.remove_prefix(end + 1);
+            Append(_out, _format, _args...);
+        }
+
+        template <class... Args>
+        void Log(const char* _level, std::string_view _format, const Args&... _args) {
+            if (isMuted.load(std::memory_order_relaxed)) return;
+
+            std::ostringstream out;
+            Append(out, _format, _args...);
+            std::fprintf(stderr, "[%s] %s\n", _level, out.str().c_str());
+        }
+    }
+
+    // Silences the log while alive, for tests that feed the sources input they are expected to complain about.
+    class ScopedMute {
+    public:
+        ScopedMute() { detail::isMuted.store(true); }
+        ~ScopedMute() { detail::isMuted.store(false); }
+    };
+
+    template <class... Args>
+    void trace(std::string_view _format, const Args&... _args) {}
+    template <class... Args>
+    void debug(std::string_view _format, const Args&... _args) {}
+    template <class... Args>
+    void info(std::string_view _format, const Args&... _args) { detail::Log("info", _format, _args...); }
+    template <class... Args>
+    void warn(std::string_view _format, const Args&... _args) { detail::Log("warn", _format, _args...); }
+    template <class... Args>
+    void error(std::string_view _format, const Args&... _args) { detail::Log("error", _format, _args...); }
+    template <class... Args>
+    void critical(std::string_view _format, const Args&... _args) { detail::Log("critical", _format, _args...); }
+}
+
+// fmt::format for the placeholders the plugin uses, with the log's substitution.
+namespace fmt {
+    template <class... Args>
+    std::string format(std::string_view _format, const Args&... _args) {
+        std::ostringstream out;
+        logger::detail::Append(out, _format, _args...);
+        return out.str();
+    }
+}
\ No newline at end of file
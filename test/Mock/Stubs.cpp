@@ -0,0 +1,65 @@
+#include "Actor.h"
+#include "Config.h"
+#include "WidgetHandler.h"
+#include "Gui/GuiMenu.h"
+#include "HUDHandler.h"
+#include "Serialize.h"
+
+// Link-time stand-ins for the plugin sources that only talk to the game: actor runtime data, the Scaleform
+// widget menu, the ImGui menu and the TOML files. Actor queries answer from the mocked player.
+namespace Actor {
+    RE::TESForm* GetEquippedShout(RE::Actor* _actor) {
+        auto player = RE::PlayerCharacter::GetSingleton();
+        return _actor == player ? player->shout : nullptr;
+    }
+
+    std::vector<RE::TESForm*> GetAllEquippedItems() {
+        auto player = RE::PlayerCharacter::GetSingleton();
+
+        std::vector<RE::TESForm*> result;
+        for (const auto& [item, data] : player->GetInventory()) {
+            const auto& [numItems, entry] = data;
+            if (numItems > 0 &&
+                (item == player->leftHand || item == player->rightHand || player->worn.contains(item))) {
+                result.push_back(item);
+            }
+        }
+        return result;
+    }
+
+    bool HasItem(RE::Actor* _actor, RE::TESForm* _form) {
+        if (!_actor || !_form) return false;
+
+        auto object = _form->As<RE::TESBoundObject>();
+        auto it = object ? _actor->container.find(object) : _actor->container.end();
+        return it != _actor->container.end() && it->second.count > 0;
+    }
+
+    bool HasMagic(RE::Actor* _actor, RE::TESForm* _spell) {
+        auto player = RE::PlayerCharacter::GetSingleton();
+        return _actor == player && _spell && std::ranges::find(player->spells, _spell) != player->spells.end();
+    }
+
+    bool HasShout(RE::Actor* _actor, RE::TESForm* _shout) { return HasMagic(_actor, _shout); }
+}
+
+std::string ConfigHandler::GetWidgetPath(const std::string& _type) { return _type; }
+
+void WidgetHandler::BeginBatch() {}
+void WidgetHandler::EndBatch() {}
+void WidgetHandler::LoadWidget(uint32_t, std::string, int32_t, int32_t, int32_t, int32_t, int32_t) {}
+void WidgetHandler::UnloadWidget(uint32_t) {}
+void WidgetHandler::LoadText(uint32_t, std::string, std::string, int32_t, int32_t, int32_t, int32_t, int32_t, bool) {}
+void WidgetHandler::UnloadText(uint32_t) {}
+void WidgetHandler::SetText(uint32_t, std::string) {}
+
+GuiMenu::GuiMenu() {}
+
+RE::BSEventNotifyControl HUDHandler::ProcessEvent(const RE::MenuOpenCloseEvent*,
+                                                  RE::BSTEventSource<RE::MenuOpenCloseEvent>*) {
+    return RE::BSEventNotifyControl::kContinue;
+}
+
+bool Serialize::ExportEquipset() { return false; }
+bool Serialize::ParseEquipset(Type, ImportBatch&, SKSE::SerializationInterface*) { return false; }
+void Serialize::CommitEquipset(ImportBatch&) {}
\ No newline at end of file
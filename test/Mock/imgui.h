@@ -0,0 +1,13 @@
+#pragma once
+
+// The names Config.h and Gui/GuiMenu.h take from Dear ImGui; the host builds never draw anything.
+enum ImGuiKey : int {
+    ImGuiKey_None = 0,
+    ImGuiKey_F6 = 577
+};
+
+struct ImFont;
+namespace ImGui {
+    // Equipset.cpp labels hotkey widgets with the key name.
+    inline const char* GetKeyName(int) { return ""; }
+}
\ No newline at end of file
@@ -0,0 +1,439 @@
+#include "EquipsetManager.h"
+#include "InputQueue.h"
+#include "Config.h"
+
+// Replays a synthetic input stream through the plugin's InputQueue, ChordAutomaton, EquipsetManager and
+// Equipset code against the mocked game (Mock/Game.h, Mock/Stubs.cpp), and reports per-event latency
+// and allocations for each library size, separately for events that equip a set, switch the layer, or neither.
+// A second pass times dispatch alone: the chord key, the automaton step and the handle lookup.
+// Usage: ReplayHarness [events per library] [library sizes...]
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0U};
+}
+
+// Every allocation bumps the counter the replay reads around each event.
+void* operator new(size_t _size) {
+    allocationCount.fetch_add(1U, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(_size ? _size : 1U)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t _size) { return operator new(_size); }
+
+void* operator new(size_t _size, const std::nothrow_t&) noexcept {
+    allocationCount.fetch_add(1U, std::memory_order_relaxed);
+    return std::malloc(_size ? _size : 1U);
+}
+
+void* operator new[](size_t _size, const std::nothrow_t& _tag) noexcept { return operator new(_size, _tag); }
+
+void operator delete(void* _ptr) noexcept { std::free(_ptr); }
+void operator delete[](void* _ptr) noexcept { std::free(_ptr); }
+void operator delete(void* _ptr, size_t) noexcept { std::free(_ptr); }
+void operator delete[](void* _ptr, size_t) noexcept { std::free(_ptr); }
+
+namespace {
+    // Bindings are spread over the layers. Within a layer the sets first take every key with each modifier combination
+    // and gesture, then the same chords behind each leader, with the modifiers pressed after the leader.
+    constexpr uint32_t layerCount{3U};
+    constexpr uint32_t firstKey{520U};
+    constexpr uint32_t keyCount{100U};
+    constexpr uint32_t layerKey{630U};
+    constexpr std::array<uint32_t, 4> leaderKeys{632U, 633U, 634U, 635U};
+    constexpr uint32_t plainCount{keyCount * 8U * 3U};
+    constexpr uint32_t chordCount{plainCount * (1U + static_cast<uint32_t>(leaderKeys.size()))};
+
+    constexpr uint32_t weaponCount{256U};
+    constexpr uint32_t armorCount{256U};
+    constexpr uint32_t potionCount{64U};
+
+    struct Forms {
+        std::vector<RE::TESForm*> weapons;
+        std::vector<RE::TESForm*> armors;
+        std::vector<RE::TESForm*> potions;
+    };
+
+    // Every form is in the player's inventory, so each equip goes through.
+    template <class T>
+    void AddItems(std::vector<RE::TESForm*>& _list, RE::TESFile* _file, RE::FormID& _id, uint32_t _count,
+                  std::string_view _prefix) {
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        auto player = RE::PlayerCharacter::GetSingleton();
+        for (uint32_t i = 0; i < _count; i++) {
+            auto form = dataHandler->AddForm<T>(_id++, _file, std::string(_prefix) + std::to_string(i));
+            player->AddObjectToContainer(form, 1);
+            _list.push_back(form);
+        }
+    }
+
+    Forms AddForms() {
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        auto file = dataHandler->AddFile("Synthetic.esp", 1U);
+
+        // NormalSet::Equip empties a hand by equipping and unequipping the game's dummy dagger.
+        dataHandler->AddForm<RE::TESObjectWEAP>(0x20163U, nullptr, "Dummy Dagger");
+
+        Forms forms;
+        RE::FormID id = 0x01000800U;
+        AddItems<RE::TESObjectWEAP>(forms.weapons, file, id, weaponCount, "Weapon ");
+        AddItems<RE::TESObjectARMO>(forms.armors, file, id, armorCount, "Armor ");
+        AddItems<RE::AlchemyItem>(forms.potions, file, id, potionCount, "Potion ");
+
+        return forms;
+    }
+
+    template <class T>
+    void SetChord(T& _equipset, uint32_t _index) {
+        auto slot = _index / layerCount;
+        _equipset.layer = _index % layerCount;
+        auto leader = slot / plainCount;
+        slot %= plainCount;
+        _equipset.hotkey = firstKey + slot % keyCount;
+        slot /= keyCount;
+        _equipset.modifier1 = slot & 1U;
+        _equipset.modifier2 = slot & 2U;
+        _equipset.modifier3 = slot & 4U;
+        _equipset.gesture = static_cast<Equipset::GESTURE>(slot / 8U);
+        _equipset.leader = leader != 0 ? leaderKeys[leader - 1U] : 0U;
+    }
+
+    // Eight of every ten sets are normal sets, then one potion set and one cycle set over earlier normal sets.
+    void BuildLibrary(uint32_t _size, const Forms& _forms, std::mt19937& _rng) {
+        auto manager = EquipsetManager::GetSingleton();
+        auto Pick = [&_rng](const std::vector<RE::TESForm*>& _list) { return _list[_rng() % _list.size()]; };
+
+        for (uint32_t i = 0; i < _size; i++) {
+            auto name = "Set " + std::to_string(i);
+            if (i % 10 == 8) {
+                PotionSet equipset;
+                equipset.type = Equipset::TYPE::POTION;
+                equipset.name = name;
+                SetChord(equipset, i);
+                equipset.health = DataPotion(Data::DATATYPE::POTION, "", Pick(_forms.potions));
+                equipset.magicka = DataPotion(Data::DATATYPE::POTION, "", Pick(_forms.potions));
+                equipset.widgetIcon.enable = true;
+                manager->Create(std::move(equipset), true);
+            } else if (i % 10 == 9) {
+                CycleSet equipset;
+                equipset.type = Equipset::TYPE::CYCLE;
+                equipset.name = name;
+                SetChord(equipset, i);
+                equipset.items = {"Set " + std::to_string(i - 2), "Set " + std::to_string(i - 3),
+                                  "Set " + std::to_string(i - 4)};
+                equipset.widgetName.enable = true;
+                manager->Create(std::move(equipset), true);
+            } else {
+                NormalSet equipset;
+                equipset.name = name;
+                SetChord(equipset, i);
+                auto left = Pick(_forms.weapons);
+                auto right = Pick(_forms.weapons);
+                equipset.lefthand = DataWeapon(Data::DATATYPE::WEAP, left->GetName(), 0U, "", 0.0f, left);
+                equipset.righthand = DataWeapon(Data::DATATYPE::WEAP, right->GetName(), 0U, "", 0.0f, right);
+                for (uint32_t j = _rng() % 5; j > 0; j--) {
+                    auto armor = Pick(_forms.armors);
+                    equipset.items.push_back(DataArmor(Data::DATATYPE::ARMOR, armor->GetName(), 0U, "", 0.0f, armor));
+                }
+                equipset.widgetIcon.enable = i % 2 == 0;
+                manager->Create(std::move(equipset), true);
+            }
+        }
+    }
+
+    // Events that activate uniformly picked sets the way a player would: switching to the set's layer, holding its
+    // modifiers, tapping its leader, then performing its gesture.
+    std::vector<InputQueue::Record> BuildStream(uint32_t _count, std::mt19937& _rng) {
+        auto manager = EquipsetManager::GetSingleton();
+        auto config = ConfigHandler::GetSingleton();
+        const auto& equipsets = manager->equipsetVec;
+
+        std::vector<InputQueue::Record> stream;
+        stream.reserve(_count + 16U);
+        auto Add = [&stream](uint32_t _code, uint8_t _modifier, InputQueue::STATE _state, float _held = 0.0f) {
+            InputQueue::Record record;
+            record.code = _code;
+            record.modifier = _modifier;
+            record.state = _state;
+            record.heldDuration = _held;
+            stream.push_back(record);
+        };
+
+        using STATE = InputQueue::STATE;
+        auto layer = manager->GetActiveLayer();
+        while (stream.size() < _count) {
+            auto equipset = equipsets[_rng() % equipsets.size()];
+            while (equipset->layer != layer) {
+                Add(layerKey, 0U, STATE::PRESS);
+                Add(layerKey, 0U, STATE::RELEASE, 0.1f);
+                layer = (layer + 1) % layerCount;
+            }
+            if (equipset->leader != 0) {
+                Add(equipset->leader, 0U, STATE::PRESS);
+                Add(equipset->leader, 0U, STATE::RELEASE, 0.1f);
+            }
+
+            std::array<uint32_t, 3> modifierKeys{config->Settings.modifier1, config->Settings.modifier2,
+                                                 config->Settings.modifier3};
+            auto mask = InputQueue::GetModifierMask(equipset->modifier1, equipset->modifier2, equipset->modifier3);
+            uint8_t held = 0U;
+            for (uint32_t i = 0; i < modifierKeys.size(); i++) {
+                if (!(mask & (1U << i))) continue;
+
+                Add(modifierKeys[i], held, STATE::PRESS);
+                held |= 1U << i;
+            }
+
+            auto hotkey = equipset->hotkey;
+            switch (equipset->gesture) {
+                case Equipset::GESTURE::PRESS:
+                    Add(hotkey, mask, STATE::PRESS);
+                    Add(hotkey, mask, STATE::RELEASE, 0.1f);
+                    break;
+                case Equipset::GESTURE::HOLD:
+                    Add(hotkey, mask, STATE::PRESS);
+                    Add(hotkey, mask, STATE::HELD, config->Settings.holdTime + 0.1f);
+                    Add(hotkey, mask, STATE::RELEASE, config->Settings.holdTime + 0.2f);
+                    break;
+                case Equipset::GESTURE::DOUBLE_TAP:
+                    Add(hotkey, mask, STATE::PRESS);
+                    Add(hotkey, mask, STATE::RELEASE, 0.05f);
+                    Add(hotkey, mask, STATE::PRESS);
+                    Add(hotkey, mask, STATE::RELEASE, 0.05f);
+                    break;
+            }
+
+            for (uint32_t i = 0; i < modifierKeys.size(); i++) {
+                if (!(held & (1U << i))) continue;
+
+                held &= ~(1U << i);
+                Add(modifierKeys[i], held, STATE::RELEASE, 0.2f);
+            }
+        }
+
+        return stream;
+    }
+
+    enum class KIND : uint32_t {
+        EQUIP,  // the event equipped a set
+        LAYER,  // the event switched the active layer
+        IDLE,  // anything else: modifiers, leaders, releases, the first tap of a double tap
+        TOTAL
+    };
+
+    constexpr std::array<const char*, static_cast<size_t>(KIND::TOTAL)> kindNames{"equip", "layer", "idle"};
+
+    // Upper bounds of the histogram buckets in nanoseconds; the last bucket takes everything slower.
+    constexpr std::array<int64_t, 6> bucketBounds{256, 1000, 4000, 16000, 64000, 256000};
+
+    struct Latencies {
+        std::vector<int64_t> samples;  // nanoseconds, sorted once the replay ends
+        uint64_t allocations{0U};
+    };
+
+    struct Result {
+        std::array<Latencies, static_cast<size_t>(KIND::TOTAL)> kinds;
+        uint64_t dispatched{0U};
+        uint64_t equips{0U};
+    };
+
+    // Each event is pushed and drained on its own, as if it were the only input of its frame, and is filed under
+    // what it did. The player is stripped before each event, outside the timing, so every set that fires equips
+    // something and is counted as an equip.
+    Result Replay(const std::vector<InputQueue::Record>& _stream) {
+        auto queue = InputQueue::GetSingleton();
+        auto task = SKSE::GetTaskInterface();
+        auto manager = EquipsetManager::GetSingleton();
+        auto equipManager = RE::ActorEquipManager::GetSingleton();
+        auto player = RE::PlayerCharacter::GetSingleton();
+
+        Result result;
+        for (auto& kind : result.kinds) {
+            kind.samples.reserve(_stream.size());
+        }
+        auto dispatched = queue->GetStats().dispatched;
+        auto startEquips = equipManager->equipCount;
+
+        for (auto record : _stream) {
+            player->leftHand = nullptr;
+            player->rightHand = nullptr;
+            player->worn.clear();
+
+            auto allocations = allocationCount.load(std::memory_order_relaxed);
+            auto layer = manager->GetActiveLayer();
+            auto equips = equipManager->equipCount + equipManager->unequipCount;
+            auto begin = std::chrono::steady_clock::now();
+
+            record.timestamp = InputQueue::Now();
+            queue->Push(record);
+            task->RunTasks();
+
+            auto end = std::chrono::steady_clock::now();
+            auto kind = manager->GetActiveLayer() != layer                                 ? KIND::LAYER
+                        : equipManager->equipCount + equipManager->unequipCount != equips ? KIND::EQUIP
+                                                                                           : KIND::IDLE;
+            auto& latencies = result.kinds[static_cast<size_t>(kind)];
+            latencies.allocations += allocationCount.load(std::memory_order_relaxed) - allocations;
+            latencies.samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+
+        result.dispatched = queue->GetStats().dispatched - dispatched;
+        result.equips = equipManager->equipCount - startEquips;
+        for (auto& kind : result.kinds) {
+            std::sort(kind.samples.begin(), kind.samples.end());
+        }
+        return result;
+    }
+
+    // Replays the stream's chords through automatons built like the manager's, one per layer, timing only what
+    // dispatch does before a set is activated. Layer switches are applied untimed and nothing is equipped.
+    Latencies ReplayDispatch(const std::vector<InputQueue::Record>& _stream, uint64_t& _fired) {
+        auto manager = EquipsetManager::GetSingleton();
+
+        std::array<ChordAutomaton, layerCount> automatons;
+        for (auto equipset : manager->equipsetVec) {
+            if (equipset->hotkey != 0) automatons[equipset->layer].Add(equipset);
+        }
+
+        Latencies latencies;
+        latencies.samples.reserve(_stream.size());
+        auto layer = manager->GetActiveLayer();
+        for (const auto& record : _stream) {
+            if (record.code == layerKey) {
+                if (record.state == InputQueue::STATE::PRESS) {
+                    automatons[layer].ResetState();
+                    layer = (layer + 1) % layerCount;
+                }
+                continue;
+            }
+
+            auto& automaton = automatons[layer];
+            auto allocations = allocationCount.load(std::memory_order_relaxed);
+            auto begin = std::chrono::steady_clock::now();
+
+            auto token = EquipsetManager::GetChordKey(record.code, record.modifier & 1U, record.modifier & 2U,
+                                                      record.modifier & 4U);
+            Equipset* fire = nullptr;
+            switch (record.state) {
+                case InputQueue::STATE::PRESS:
+                    fire = manager->Resolve(automaton.Press(token));
+                    break;
+                case InputQueue::STATE::HELD:
+                    fire = manager->Resolve(automaton.Held(token, record.heldDuration));
+                    break;
+                case InputQueue::STATE::RELEASE: {
+                    auto result = automaton.Release(token, record.heldDuration);
+                    fire = manager->Resolve(result.fire);
+                    if (!fire) fire = manager->Resolve(result.release);
+                    break;
+                }
+            }
+
+            auto end = std::chrono::steady_clock::now();
+            if (fire) _fired++;
+            latencies.allocations += allocationCount.load(std::memory_order_relaxed) - allocations;
+            latencies.samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+
+        std::sort(latencies.samples.begin(), latencies.samples.end());
+        return latencies;
+    }
+
+    int64_t Percentile(const std::vector<int64_t>& _sorted, double _p) {
+        return _sorted[static_cast<size_t>(_p * static_cast<double>(_sorted.size() - 1))];
+    }
+
+    void PrintHeader() {
+        std::printf("%8s %6s %8s %9s %9s %9s %9s %8s |", "sets", "kind", "events", "p50 ns", "p99 ns", "p99.9 ns",
+                    "max ns", "allocs/ev");
+        for (auto bound : bucketBounds) {
+            std::printf(" %7s", (bound < 1000 ? "<=" + std::to_string(bound) + "ns"
+                                              : "<=" + std::to_string(bound / 1000) + "us")
+                                    .c_str());
+        }
+        std::printf(" %7s\n", ">last");
+    }
+
+    void PrintRow(uint32_t _size, const char* _kind, const Latencies& _latencies) {
+        const auto& samples = _latencies.samples;
+        std::printf("%8u %6s %8zu", _size, _kind, samples.size());
+        if (samples.empty()) {
+            std::printf("\n");
+            return;
+        }
+
+        std::printf(" %9lld %9lld %9lld %9lld %8.2f |", static_cast<long long>(Percentile(samples, 0.5)),
+                    static_cast<long long>(Percentile(samples, 0.99)),
+                    static_cast<long long>(Percentile(samples, 0.999)), static_cast<long long>(samples.back()),
+                    static_cast<double>(_latencies.allocations) / static_cast<double>(samples.size()));
+
+        auto first = samples.begin();
+        for (auto bound : bucketBounds) {
+            auto last = std::upper_bound(first, samples.end(), bound);
+            std::printf(" %7lld", static_cast<long long>(last - first));
+            first = last;
+        }
+        std::printf(" %7lld\n", static_cast<long long>(samples.end() - first));
+    }
+
+    bool ParseNumber(std::string_view _text, uint32_t& _value) {
+        auto [ptr, ec] = std::from_chars(_text.data(), _text.data() + _text.size(), _value);
+        return ec == std::errc() && ptr == _text.data() + _text.size() && _value != 0;
+    }
+}
+
+int main(int _argc, char** _argv) {
+    uint32_t eventCount = 20000U;
+    std::vector<uint32_t> sizes{10U, 100U, 1000U, 10000U};
+    if (_argc > 1 && !ParseNumber(_argv[1], eventCount)) {
+        std::fprintf(stderr, "usage: %s [events per library] [library sizes...]\n", _argv[0]);
+        return 2;
+    }
+    if (_argc > 2) {
+        sizes.clear();
+        for (int i = 2; i < _argc; i++) {
+            uint32_t size = 0U;
+            if (!ParseNumber(_argv[i], size) || size > chordCount * layerCount) {
+                std::fprintf(stderr, "library sizes must be between 1 and %u\n", chordCount * layerCount);
+                return 2;
+            }
+            sizes.push_back(size);
+        }
+    }
+
+    auto config = ConfigHandler::GetSingleton();
+    config->Settings.layers = {"Default", "Second", "Third"};
+    config->Settings.layerHotkey = layerKey;
+
+    auto forms = AddForms();
+    auto manager = EquipsetManager::GetSingleton();
+
+    PrintHeader();
+
+    bool isFailed = false;
+    for (auto size : sizes) {
+        std::mt19937 rng(size);
+        manager->RemoveAll();
+        BuildLibrary(size, forms, rng);
+
+        // The warm-up pass grows the queue's and automaton's buffers so the measured pass sees steady state.
+        Replay(BuildStream(1000U, rng));
+        auto result = Replay(BuildStream(eventCount, rng));
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(KIND::TOTAL); i++) {
+            PrintRow(size, kindNames[i], result.kinds[i]);
+        }
+
+        uint64_t fired = 0U;
+        auto stream = BuildStream(eventCount, rng);
+        ReplayDispatch(stream, fired);
+        PrintRow(size, "chord", ReplayDispatch(stream, fired));
+
+        // Every library binds its sets, so a replay that equips nothing means dispatch broke.
+        if (result.dispatched == 0 || result.equips == 0 || fired == 0) isFailed = true;
+    }
+    std::fflush(stdout);
+
+    return isFailed ? 1 : 0;
+}
\ No newline at end of file